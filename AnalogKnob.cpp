@@ -1,13 +1,107 @@
 #include "AnalogKnob.h"
 
-float AnalogKnob::getValue() {
-    last_value = analogRead(input);
-    float value = last_value/1000.0;
-    if (value>1.0) value=1.0;
-    return value;
+void AnalogKnob::update() {
+    addSample(analogRead(input));
+}
+
+void AnalogKnob::addSample(uint16_t raw) {
+    sampleSum += raw;
+    if (++sampleCount < (1<<oversamplingBits)) return;
+    uint16_t sample = (sampleSum >> oversamplingBits) << ANALOG_KNOB_FILTER_BITS;
+    sampleCount = 0;
+    sampleSum = 0;
+    if (!valid) {
+        // start from the first sample instead of ramping up from zero
+        filterState = sample;
+        valid = true;
+        return;
+    }
+    filterState += ((int32_t)sample - (int32_t)filterState) >> filterShift;
+}
+
+void AnalogKnob::setFullScale(uint16_t counts) {
+    if (counts==0) counts = 1;
+    fullScale = counts;
+    // rounded; reciprocal*fullScale stays below 2^32, so counts*reciprocal cannot overflow for counts<=fullScale
+    reciprocal = (0xFFFF0000UL + (counts>>1)) / counts;
+}
+
+uint16_t AnalogKnob::getCounts() {
+    last_value = getFiltered();
+    return (last_value<fullScale) ? last_value : fullScale;
+}
+
+uint16_t AnalogKnob::getFraction() {
+    uint16_t counts = getCounts();
+    if (counts>=fullScale) return 0xFFFF;
+    return (counts*reciprocal + 0x8000) >> 16;
 }
     
 bool AnalogKnob::hasChanged() {
-    float value = analogRead(input);
-    return (abs(value-last_value)>deadzone);
-}
\ No newline at end of file
+    if (!sampled) update();
+    if (!valid) return false;
+    uint16_t value = getFiltered();
+    if (abs((int16_t)value-(int16_t)last_value)>deadzone) return true;
+    // the end stops are always reached, even if closer than the dead zone
+    if (value==0) return last_value!=0;
+    if (value>=fullScale) return last_value<fullScale;
+    return false;
+}
+
+bool AnalogSampler::addKnob(AnalogKnob* knob) {
+    if (count>=ANALOG_SAMPLER_MAX) return false;
+    knob->sampled = true;
+    knobs[count++] = knob;
+    return true;
+}
+
+#if defined(__AVR__) && defined(ADCSRA) && defined(ADSC)
+
+// reference selected with analogReference(), kept by the AVR core in wiring_analog.c
+extern "C" uint8_t analog_reference;
+
+void AnalogSampler::startConversion(uint8_t pin) {
+    // same channel mapping as analogRead() in the AVR core
+#if defined(analogPinToChannel)
+    if (pin >= 18) pin -= 18;
+    pin = analogPinToChannel(pin);
+#elif defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)
+    if (pin >= 54) pin -= 54;
+#else
+    if (pin >= 14) pin -= 14;
+#endif
+#if defined(ADCSRB) && defined(MUX5)
+    ADCSRB = (ADCSRB & ~(1 << MUX5)) | (((pin >> 3) & 0x01) << MUX5);
+#endif
+    // the reference of the sketch: a hard-coded AVcc would short an external AREF supply
+    ADMUX = (analog_reference << 6) | (pin & 0x07);
+    ADCSRA |= _BV(ADSC);
+    converting = true;
+}
+
+bool AnalogSampler::update() {
+    if (count==0) return false;
+    if (!converting) {
+        startConversion(knobs[current]->getInput());
+        return false;
+    }
+    if (ADCSRA & _BV(ADSC)) return false; // conversion still running
+    knobs[current]->addSample(ADC);
+    if (++current>=count) current = 0;
+    startConversion(knobs[current]->getInput());
+    return true;
+}
+
+#else
+
+void AnalogSampler::startConversion(uint8_t pin) {
+}
+
+bool AnalogSampler::update() {
+    if (count==0) return false;
+    knobs[current]->addSample(analogRead(knobs[current]->getInput()));
+    if (++current>=count) current = 0;
+    return true;
+}
+
+#endif
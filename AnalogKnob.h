@@ -3,20 +3,136 @@
 
 #include <Arduino.h>
 
+// fractional bits of the IIR filter state (10 bit ADC value << 5 still fits 16 bit)
+#define ANALOG_KNOB_FILTER_BITS 5
+
+// ADC count of the end stop (10 bit ADC)
+#ifndef ANALOG_KNOB_FULL_SCALE
+#define ANALOG_KNOB_FULL_SCALE 1023
+#endif
+
+// maximum number of knobs that can share one AnalogSampler
+#ifndef ANALOG_SAMPLER_MAX
+#define ANALOG_SAMPLER_MAX 4
+#endif
+
+/**
+ * @class AnalogKnob
+ * @file AnalogKnob.h
+ * @brief Analog input (e.g. potentiometer) with oversampling, an IIR low-pass filter and hysteresis. Samples come either from
+ *        update() (one analogRead per call) or from an AnalogSampler that converts in the background. hasChanged() and getValue()
+ *        only look at the cached filtered value and never start a conversion themselves, except that hasChanged() calls update()
+ *        when the knob is not attached to a sampler.
+ */
 class AnalogKnob {
 private:
     uint8_t input;
-    uint16_t last_value;
+    uint16_t last_value;      // filtered value at the last getValue() (reference for the hysteresis)
     uint16_t deadzone;
+    uint16_t fullScale;       // filtered value at the end stop
+    uint32_t reciprocal;      // 65535*2^16/fullScale, maps counts to fractions by a multiply and a shift
+    uint8_t oversamplingBits; // 2^oversamplingBits raw samples are averaged per filter step
+    uint8_t filterShift;      // IIR coefficient 1/2^filterShift (0: no filtering)
+    uint8_t sampleCount;
+    uint16_t sampleSum;
+    uint16_t filterState;     // filtered value with ANALOG_KNOB_FILTER_BITS fractional bits
+    bool valid;               // at least one filter step has been done
+    bool sampled;             // attached to an AnalogSampler
+    
+    friend class AnalogSampler;
 public:
-    AnalogKnob(uint8_t input, uint16_t deadzone=5) :
-    input(input), last_value(0), deadzone(deadzone)
-    {};
+    /**
+     * @brief Constructor for an analog knob.
+     * @param input Analog input pin
+     * @param deadzone Hysteresis in ADC counts: hasChanged() is only true after the filtered value moved further than this
+     * @param oversamplingBits Averages 2^oversamplingBits raw samples per filter step (0..4)
+     * @param filterShift Strength of the IIR low-pass: each step moves 1/2^filterShift towards the new sample (0: off)
+     * @param fullScale ADC count at the end stop, mapped to the maximum of a parameter
+     */
+    AnalogKnob(uint8_t input, uint16_t deadzone=5, uint8_t oversamplingBits=0, uint8_t filterShift=2, uint16_t fullScale=ANALOG_KNOB_FULL_SCALE) :
+    input(input), last_value(0), deadzone(deadzone), oversamplingBits(oversamplingBits>4 ? 4 : oversamplingBits), filterShift(filterShift),
+    sampleCount(0), sampleSum(0), filterState(0), valid(false), sampled(false)
+    {setFullScale(fullScale);};
+    
+    /**
+     * @brief Takes one sample with analogRead (blocking). Not needed when the knob is attached to an AnalogSampler.
+     */
+    void update();
     
-    float getValue();
+    /**
+     * @brief Feeds one raw ADC sample into oversampling and filter.
+     * @param raw ADC value (0..1023)
+     */
+    void addSample(uint16_t raw);
     
+    /**
+     * @brief Returns the filtered value and makes it the reference for hasChanged().
+     * @return filtered value in ADC counts, 0..fullScale
+     */
+    uint16_t getCounts();
+    
+    /**
+     * @brief Returns the filtered value as a fraction of the full scale (integer arithmetic), and makes it the reference for
+     *        hasChanged(). This is the scale of Parameter::setScaledFraction().
+     * @return 0 at zero .. 65535 at the full scale and above
+     */
+    uint16_t getFraction();
+    
+    /**
+     * @brief Float version of getFraction().
+     * @return filtered value, scaled to 0.0 .. 1.0
+     */
+    float getValue() {return getFraction()*(1.0f/65535.0f);};
+    
+    /**
+     * @brief Checks if the filtered value moved further than the dead zone since the last getValue().
+     */
     bool hasChanged();
     
+    /**
+     * @brief Filtered value in ADC counts, without affecting hasChanged().
+     */
+    uint16_t getFiltered() {return (filterState + (1<<(ANALOG_KNOB_FILTER_BITS-1))) >> ANALOG_KNOB_FILTER_BITS;};
+    
+    uint8_t getInput() {return input;};
+    
+    /**
+     * @brief Sets the ADC count of the end stop, e.g. less than 1023 if the potentiometer does not reach the supply (up to 2047).
+     */
+    void setFullScale(uint16_t counts);
+    uint16_t getFullScale() {return fullScale;};
+};
+
+/**
+ * @class AnalogSampler
+ * @file AnalogKnob.h
+ * @brief Samples several AnalogKnobs round-robin without blocking. On AVR, update() starts an ADC conversion and returns; the result
+ *        is collected by a later call once the conversion has finished, so the main loop never waits ~100us for the ADC.
+ *        Other platforms fall back to one analogRead per update(). Do not mix with analogRead() calls on AVR while a conversion is pending.
+ *        Conversions use the reference selected with analogReference(), like analogRead().
+ */
+class AnalogSampler {
+private:
+    AnalogKnob* knobs[ANALOG_SAMPLER_MAX];
+    uint8_t count;
+    uint8_t current;
+    bool converting;
+    
+    void startConversion(uint8_t pin);
+public:
+    AnalogSampler(): count(0), current(0), converting(false) {};
+    
+    /**
+     * @brief Adds a knob to the round-robin. Its hasChanged() will no longer sample by itself.
+     * @return false if ANALOG_SAMPLER_MAX knobs are already attached
+     */
+    bool addKnob(AnalogKnob* knob);
+    
+    /**
+     * @brief Call regularly from the main loop. Collects a finished conversion and starts the next channel.
+     * @return true if a sample was delivered to a knob
+     */
+    bool update();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,115 @@
+#include "ButtonBank.h"
+#include "MenuStats.h"
+
+bool BankButton::pushed() {
+    bank->update();
+    return bank->pushed(index);
+}
+
+bool BankButton::released() {
+    bank->update();
+    return bank->released(index);
+}
+
+bool BankButton::currentlyPushed() {
+    bank->update();
+    return bank->currentlyPushed(index);
+}
+
+bool BankButton::longPressed() {
+    bank->update();
+    return bank->longPressed(index);
+}
+
+ButtonBank::ButtonBank(const uint8_t* pins, uint8_t count, uint8_t tickTime, uint8_t config, uint8_t activeState):
+    pins(pins), count(count>8 ? 8 : count), activeState(activeState), readPort(NULL), tickTime(tickTime ? tickTime : 1), lastTick(0),
+    state(0), counter0(0xFF), counter1(0xFF), pressedBits(0), releasedBits(0), longBits(0),
+    repeatMask(0), repeatDelay(0), repeatPeriod(0), repeatCounter(0), longMask(0), longTime(0), longCounter(0) {
+    for (uint8_t i=0; i<this->count; i++) pinMode(pins[i], config);
+}
+
+ButtonBank::ButtonBank(uint8_t (*readPort)(), uint8_t tickTime):
+    pins(NULL), count(8), activeState(HIGH), readPort(readPort), tickTime(tickTime ? tickTime : 1), lastTick(0),
+    state(0), counter0(0xFF), counter1(0xFF), pressedBits(0), releasedBits(0), longBits(0),
+    repeatMask(0), repeatDelay(0), repeatPeriod(0), repeatCounter(0), longMask(0), longTime(0), longCounter(0) {
+}
+
+void ButtonBank::setRepeat(uint8_t mask, uint16_t delay, uint16_t period) {
+    repeatMask = mask;
+    repeatPeriod = toTicks(period);
+    // the counter counts down to 0 and must not start there: no delay means the first repeat after one period
+    repeatDelay = (delay>0) ? toTicks(delay) : repeatPeriod;
+    repeatCounter = repeatDelay;
+}
+
+void ButtonBank::setLongPress(uint8_t mask, uint16_t time) {
+    longMask = mask;
+    longTime = toTicks(time);
+    longCounter = 0;
+}
+
+uint8_t ButtonBank::sample() {
+    if (readPort!=NULL) return readPort();
+    uint8_t bits = 0;
+    for (uint8_t i=0; i<count; i++) {
+        if (digitalRead(pins[i])==activeState) bits |= 1<<i;
+    }
+    return bits;
+}
+
+bool ButtonBank::update() {
+    uint32_t now = millis();
+    if (now-lastTick < tickTime) return false;
+    lastTick = now;
+    MENU_STATS_STAGE(STAGE_INPUT);
+
+    // vertical counters: each button has a 2-bit counter spread over counter0/counter1, which is reset
+    // while the sample equals the de-bounced state and toggles the state after 4 differing samples
+    uint8_t changed = state ^ sample();
+    counter0 = ~(counter0 & changed);
+    counter1 = counter0 ^ (counter1 & changed);
+    changed &= counter0 & counter1;
+    state ^= changed;
+    uint8_t pushedNow = state & changed;
+    pressedBits |= pushedNow;
+    if (pushedNow) MENU_STATS_INPUT();
+    releasedBits |= ~state & changed;
+
+    // auto-repeat for all held buttons of the repeat mask, timed from the latest push
+    if (repeatPeriod>0) {
+        if (((state & repeatMask)==0) || (pushedNow & repeatMask)) {
+            repeatCounter = repeatDelay;
+        } else if (--repeatCounter==0) {
+            repeatCounter = repeatPeriod;
+            pressedBits |= state & repeatMask;
+        }
+    }
+
+    // long press fires once per hold
+    if (longTime>0) {
+        if (((state & longMask)==0) || (pushedNow & longMask)) {
+            longCounter = 0;
+        } else if (longCounter<longTime) {
+            if (++longCounter==longTime) longBits |= state & longMask;
+        }
+    }
+    return true;
+}
+
+uint8_t ButtonBank::getPushed(uint8_t mask) {
+    uint8_t bits = pressedBits & mask;
+    pressedBits &= ~mask;
+    return bits;
+}
+
+uint8_t ButtonBank::getReleased(uint8_t mask) {
+    uint8_t bits = releasedBits & mask;
+    releasedBits &= ~mask;
+    return bits;
+}
+
+uint8_t ButtonBank::getLongPressed(uint8_t mask) {
+    uint8_t bits = longBits & mask;
+    longBits &= ~mask;
+    return bits;
+}
@@ -0,0 +1,151 @@
+#ifndef BUTTON_BANK_H
+#define BUTTON_BANK_H
+#include <Arduino.h>
+
+class ButtonBank;
+
+/**
+ * @class BankButton
+ * @file ButtonBank.h
+ * @brief Handle to one button of a ButtonBank, with the same interface as ButtonPress so that sketches can switch over
+ *        by replacing the declarations.
+ */
+class BankButton {
+private:
+    ButtonBank* bank;
+    uint8_t index;
+public:
+    BankButton(ButtonBank* bank, uint8_t index):
+    bank(bank), index(index) {};
+
+    /**
+     * @brief True only once for each button push. Repeats at the period configured in the bank.
+     */
+    bool pushed();
+
+    /**
+     * @brief True only once for each button push after release.
+     */
+    bool released();
+
+    /**
+     * @brief Current de-bounced state of button.
+     */
+    bool currentlyPushed();
+
+    /**
+     * @brief True once when the button has been held for the long-press time configured in the bank.
+     */
+    bool longPressed();
+};
+
+/**
+ * @class ButtonBank
+ * @file ButtonBank.h
+ * @brief De-bounces up to 8 buttons in parallel. All inputs are sampled once per tick (one port read, or one bit mask assembled
+ *        from pins) and filtered with 2-bit vertical counters: a change is accepted after 4 equal samples, and 8 buttons cost the
+ *        same few bitwise operations as one. Press, release, repeat and long-press events are latched as bit masks until read.
+ *        Auto-repeat and long-press use one shared timer each, which restarts whenever a button of the respective mask is pushed.
+ */
+class ButtonBank {
+private:
+    const uint8_t* pins;
+    uint8_t count;
+    uint8_t activeState;
+    uint8_t (*readPort)();
+    uint8_t tickTime;
+    uint32_t lastTick;
+
+    // de-bounced state and vertical counter bits (one bit per button)
+    uint8_t state;
+    uint8_t counter0;
+    uint8_t counter1;
+
+    // latched events, cleared when read
+    uint8_t pressedBits;
+    uint8_t releasedBits;
+    uint8_t longBits;
+
+    uint8_t repeatMask;
+    uint16_t repeatDelay;  // in ticks
+    uint16_t repeatPeriod; // in ticks
+    uint16_t repeatCounter;
+
+    uint8_t longMask;
+    uint16_t longTime;     // in ticks
+    uint16_t longCounter;
+
+    uint8_t sample();
+    uint16_t toTicks(uint16_t ms) {return ms ? (ms+tickTime-1)/tickTime : 0;};
+public:
+    /**
+     * @brief Constructor for a bank of buttons on individual pins.
+     * @param pins Array of up to 8 input pins. Button i is bit i in all masks.
+     * @param count Number of pins in the array
+     * @param tickTime Sampling period in milliseconds. A change is accepted after 4 equal samples.
+     * @param config Pin state flag (pull-up, pull-down, etc.) for pin configuration.
+     * @param activeState Polarity of buttons. Default: low when pushed.
+     */
+    ButtonBank(const uint8_t* pins, uint8_t count, uint8_t tickTime=5, uint8_t config=INPUT_PULLUP, uint8_t activeState=LOW);
+
+    /**
+     * @brief Constructor for a bank read as one port, e.g. uint8_t readButtons() {return ~PIND & 0xF0;}
+     * @param readPort Function returning a bit mask with a 1 for every pushed button. Configure the pins yourself.
+     * @param tickTime Sampling period in milliseconds. A change is accepted after 4 equal samples.
+     */
+    ButtonBank(uint8_t (*readPort)(), uint8_t tickTime=5);
+
+    /**
+     * @brief Configures auto-repeat.
+     * @param mask Buttons that repeat
+     * @param delay Time in milliseconds before the first repeat (0: one period)
+     * @param period Time in milliseconds between repeats (0: no repeat)
+     */
+    void setRepeat(uint8_t mask, uint16_t delay, uint16_t period);
+
+    /**
+     * @brief Configures long-press detection.
+     * @param mask Buttons that report long presses
+     * @param time Time in milliseconds a button has to be held
+     */
+    void setLongPress(uint8_t mask, uint16_t time);
+
+    /**
+     * @brief Samples and de-bounces all buttons if the tick time has passed. Cheap to call more often.
+     * @return true if a new sample was taken
+     */
+    bool update();
+
+    /**
+     * @brief Returns and clears push events (including auto-repeats).
+     * @param mask buttons to read
+     */
+    uint8_t getPushed(uint8_t mask=0xFF);
+
+    /**
+     * @brief Returns and clears release events.
+     */
+    uint8_t getReleased(uint8_t mask=0xFF);
+
+    /**
+     * @brief Returns and clears long-press events.
+     */
+    uint8_t getLongPressed(uint8_t mask=0xFF);
+
+    /**
+     * @brief De-bounced state of all buttons.
+     */
+    uint8_t getState() {return state;};
+
+    bool pushed(uint8_t index) {return getPushed(1<<index)!=0;};
+    bool released(uint8_t index) {return getReleased(1<<index)!=0;};
+    bool longPressed(uint8_t index) {return getLongPressed(1<<index)!=0;};
+    bool currentlyPushed(uint8_t index) {return (state>>index) & 1;};
+
+    /**
+     * @brief Handle to a single button, with the ButtonPress interface.
+     */
+    BankButton button(uint8_t index) {return BankButton(this, index);};
+};
+
+#endif
@@ -1,18 +1,22 @@
 #include "ButtonPress.h"
+#include "MenuStats.h"
 
 bool ButtonPress::pushed() {
+    MENU_STATS_STAGE(STAGE_INPUT);
     bool state = digitalRead(pin) == activeState;
     uint32_t now = millis();
     if (state) {
         if (!lastState) {
             lastChange=now;
             lastState=true;
+            MENU_STATS_INPUT();
             return true;
         } else {
             // do auto-repeat
             if ((repeatPeriod>0) && (now-lastChange>repeatPeriod + filterTime)) {
                 lastChange=now;
                 lastState=true;
+                MENU_STATS_INPUT();
                 return true;                
             } 
         }
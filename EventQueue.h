@@ -0,0 +1,88 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+#include <Arduino.h>
+
+// compiler barrier: keeps the element store ahead of the index update that publishes it
+#define EVENT_QUEUE_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+/**
+ * @class EventQueue
+ * @file EventQueue.h
+ * @brief Lock-free ring buffer for exactly one producer and one consumer, e.g. an interrupt handler
+ *        pushing and the main loop popping. Each side only writes its own index, so no interrupts have to be disabled.
+ *        SIZE must be a power of two (up to 128); the queue holds SIZE-1 elements.
+ */
+template <typename T, uint8_t SIZE>
+class EventQueue {
+private:
+    T buffer[SIZE];
+    volatile uint8_t head; // next slot to write (producer)
+    volatile uint8_t tail; // next slot to read (consumer)
+    volatile bool overflow;
+public:
+    EventQueue(): head(0), tail(0), overflow(false) {
+        static_assert((SIZE & (SIZE-1))==0 && SIZE>=2 && SIZE<=128, "EventQueue size must be a power of two");
+    };
+
+    /**
+     * @brief Appends an element. Producer side only.
+     * @param value element to append
+     * @return false if the queue was full and the element was dropped
+     */
+    bool push(const T& value) {
+        uint8_t h = head;
+        uint8_t next = (h+1) & (SIZE-1);
+        if (next==tail) {
+            overflow = true;
+            return false;
+        }
+        buffer[h] = value;
+        EVENT_QUEUE_BARRIER();
+        head = next;
+        return true;
+    };
+
+    /**
+     * @brief Removes the oldest element. Consumer side only.
+     * @param value receives the element
+     * @return false if the queue was empty
+     */
+    bool pop(T& value) {
+        uint8_t t = tail;
+        if (t==head) return false;
+        value = buffer[t];
+        EVENT_QUEUE_BARRIER();
+        tail = (t+1) & (SIZE-1);
+        return true;
+    };
+
+    /**
+     * @brief Returns the oldest element without removing it. Consumer side only.
+     */
+    bool peek(T& value) {
+        uint8_t t = tail;
+        if (t==head) return false;
+        value = buffer[t];
+        return true;
+    };
+
+    bool isEmpty() {return head==tail;};
+
+    uint8_t count() {return (head-tail) & (SIZE-1);};
+
+    /**
+     * @brief Reports and clears the flag set when push() had to drop an element.
+     */
+    bool checkOverflow() {
+        bool result = overflow;
+        overflow = false;
+        return result;
+    };
+
+    /**
+     * @brief Discards all elements. Consumer side only.
+     */
+    void clear() {tail = head;};
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "InterruptButtons.h"
+#include "MenuStats.h"
+
+#if INTERRUPT_BUTTONS_MAX > 8
+#error "InterruptButtons provides interrupt handlers for at most 8 buttons"
+#endif
+
+// attachInterrupt handlers carry no argument, so there is one handler per button index
+static InterruptButtons* attachedButtons = NULL;
+
+template <uint8_t BUTTON>
+static void buttonInterrupt() {
+    if (attachedButtons!=NULL) attachedButtons->handleEdge(BUTTON);
+}
+
+static void (* const buttonInterrupts[8])(void) = {
+    buttonInterrupt<0>, buttonInterrupt<1>, buttonInterrupt<2>, buttonInterrupt<3>,
+    buttonInterrupt<4>, buttonInterrupt<5>, buttonInterrupt<6>, buttonInterrupt<7>
+};
+
+int8_t InterruptButtons::addButton(uint8_t pin, menu_event_t event, uint16_t repeatPeriod, uint16_t filterTime, uint8_t config, uint8_t activeState) {
+    if (count>=INTERRUPT_BUTTONS_MAX) return -1;
+    ButtonState& button = buttons[count];
+    button.pin = pin;
+    button.activeState = activeState;
+    button.event = event;
+    button.filterTime = filterTime;
+    button.repeatPeriod = repeatPeriod;
+    button.pushed = false;
+    button.active = false;
+    button.lastChange = 0;
+    pinMode(pin, config);
+    return count++;
+}
+
+void InterruptButtons::begin() {
+    attachedButtons = this;
+    for (uint8_t i=0; i<count; i++) {
+        buttons[i].active = digitalRead(buttons[i].pin)==buttons[i].activeState;
+        int8_t interrupt = digitalPinToInterrupt(buttons[i].pin);
+        if (interrupt!=NOT_AN_INTERRUPT) attachInterrupt(interrupt, buttonInterrupts[i], CHANGE);
+    }
+}
+
+void InterruptButtons::end() {
+    for (uint8_t i=0; i<count; i++) {
+        int8_t interrupt = digitalPinToInterrupt(buttons[i].pin);
+        if (interrupt!=NOT_AN_INTERRUPT) detachInterrupt(interrupt);
+    }
+    attachedButtons = NULL;
+}
+
+void InterruptButtons::handleEdge(uint8_t button) {
+    if (button>=count) return;
+    button_edge_t edge;
+    edge.time = millis();
+    edge.button = button;
+    edge.active = digitalRead(buttons[button].pin)==buttons[button].activeState;
+    edges.push(edge);
+}
+
+void InterruptButtons::processEdge(const button_edge_t& edge, MenuEventQueue& events) {
+    ButtonState& button = buttons[edge.button];
+    // a release is accepted once the filter time after the push has passed (same rule as ButtonPress)
+    if (button.pushed && !button.active && (edge.time-button.lastChange > button.filterTime)) {
+        button.pushed = false;
+    }
+    button.active = edge.active;
+    if (edge.active && !button.pushed) {
+        button.pushed = true;
+        button.lastChange = edge.time;
+        events.push(button.event);
+        MENU_STATS_INPUT();
+    }
+}
+
+void InterruptButtons::resync(MenuEventQueue& events) {
+    // edges were dropped: continue from the current pin levels
+    button_edge_t edge;
+    edge.time = millis();
+    for (uint8_t i=0; i<count; i++) {
+        edge.button = i;
+        edge.active = digitalRead(buttons[i].pin)==buttons[i].activeState;
+        if (edge.active!=buttons[i].active) processEdge(edge, events);
+    }
+}
+
+void InterruptButtons::poll(MenuEventQueue& events) {
+    MENU_STATS_STAGE(STAGE_INPUT);
+    button_edge_t edge;
+    while (edges.pop(edge)) processEdge(edge, events);
+    if (edges.checkOverflow()) resync(events);
+
+    uint32_t now = millis();
+    for (uint8_t i=0; i<count; i++) {
+        ButtonState& button = buttons[i];
+        if (!button.pushed) continue;
+        if (button.active) {
+            // auto-repeat while held
+            if ((button.repeatPeriod>0) && (now-button.lastChange > button.repeatPeriod + button.filterTime)) {
+                button.lastChange = now;
+                events.push(button.event);
+                MENU_STATS_INPUT();
+            }
+        } else if (now-button.lastChange > button.filterTime) {
+            button.pushed = false;
+        }
+    }
+}
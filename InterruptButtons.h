@@ -0,0 +1,98 @@
+#ifndef INTERRUPT_BUTTONS_H
+#define INTERRUPT_BUTTONS_H
+#include <Arduino.h>
+#include "EventQueue.h"
+#include "Menu.h"
+
+// maximum number of buttons handled by InterruptButtons
+#ifndef INTERRUPT_BUTTONS_MAX
+#define INTERRUPT_BUTTONS_MAX 8
+#endif
+
+// number of pin edges that can be buffered between two calls of InterruptButtons::poll (power of two)
+#ifndef INTERRUPT_BUTTONS_EDGE_QUEUE
+#define INTERRUPT_BUTTONS_EDGE_QUEUE 16
+#endif
+
+// A pin level change, time-stamped in the interrupt handler
+typedef struct button_edge_t {
+    uint32_t time;   // millis() at the edge
+    uint8_t button;  // index of the button
+    bool active;     // true if the pin changed to its active (pushed) level
+} button_edge_t;
+
+/**
+ * @class InterruptButtons
+ * @file InterruptButtons.h
+ * @brief Interrupt-driven alternative to polling ButtonPress objects. Pin change interrupts time-stamp every edge
+ *        into a lock-free queue, and poll() resolves de-bouncing and auto-repeat from those time stamps with the same rules
+ *        as ButtonPress, producing menu events. Pushes are not lost while the main loop is busy (e.g. during a long display
+ *        update), and idle pins cost nothing.
+ *
+ *        Only one instance can be attached to interrupts. begin() uses attachInterrupt() for pins that have an external interrupt
+ *        (digitalPinToInterrupt). For other pins (e.g. AVR pin change interrupts), call handleEdge(button) from your own ISR.
+ */
+class InterruptButtons {
+private:
+    struct ButtonState {
+        uint8_t pin;
+        uint8_t activeState;
+        menu_event_t event;   // event emitted on push and auto-repeat
+        uint16_t filterTime;
+        uint16_t repeatPeriod;
+        bool pushed;          // de-bounced state
+        bool active;          // raw level at the last edge
+        uint32_t lastChange;  // time of the accepted push or last repeat
+    };
+    ButtonState buttons[INTERRUPT_BUTTONS_MAX];
+    uint8_t count;
+    EventQueue<button_edge_t, INTERRUPT_BUTTONS_EDGE_QUEUE> edges;
+
+    void processEdge(const button_edge_t& edge, MenuEventQueue& events);
+    void resync(MenuEventQueue& events);
+public:
+    InterruptButtons(): count(0) {};
+
+    /**
+     * @brief Adds a button. Call before begin().
+     * @param pin Input pin to use for the button
+     * @param event Menu event generated when the button is pushed (and auto-repeated)
+     * @param repeatPeriod Time in milliseconds after which the event is repeated when the button is held down (0: no repeat).
+     * @param filterTime De-bouncing rejection time span in milliseconds
+     * @param config Pin state flag (pull-up, pull-down, etc.) for pin configuration.
+     * @param activeState Polarity of button. Default: low when pushed.
+     * @return index of the button, or -1 if INTERRUPT_BUTTONS_MAX buttons are already registered
+     */
+    int8_t addButton(uint8_t pin, menu_event_t event, uint16_t repeatPeriod=0, uint16_t filterTime=100, uint8_t config=INPUT_PULLUP, uint8_t activeState=LOW);
+
+    /**
+     * @brief Configures the pins and attaches the interrupt handlers.
+     */
+    void begin();
+
+    /**
+     * @brief Detaches the interrupt handlers.
+     */
+    void end();
+
+    /**
+     * @brief Records an edge of a button. Called from the interrupt handler; call it from your own pin change ISR
+     *        for pins without an external interrupt.
+     * @param button index returned by addButton
+     */
+    void handleEdge(uint8_t button);
+
+    /**
+     * @brief Resolves the recorded edges and auto-repeat into menu events. Call this regularly from the main loop,
+     *        then hand the queue to Menu::navigateMenu.
+     * @param events Queue receiving the menu events
+     */
+    void poll(MenuEventQueue& events);
+
+    /**
+     * @brief Current de-bounced state of a button (as of the last poll).
+     */
+    bool currentlyPushed(uint8_t button) {return (button<count) && buttons[button].pushed;};
+};
+
+#endif
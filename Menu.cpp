@@ -1,11 +1,24 @@
 #include "Menu.h"
+#include "MenuStats.h"
 
 bool MenuItem::update(menu_event_t event) {
     return false; // nothing to do - just return false
 };
 
-void MenuItem::getText(char* buffer) {
-    strcpy(buffer, name);
+bool MenuItem::updateSteps(int16_t steps) {
+    bool active = true;
+    for (; active && (steps>0); steps--) active = update(MENU_UP);
+    for (; active && (steps<0); steps++) active = update(MENU_DOWN);
+    return active;
+};
+
+void MenuItem::printText(Print& out) {
+    out.print(name);
+}
+
+void MenuItem::getText(char* buffer, uint8_t size) {
+    MenuTextBuffer text(buffer, size);
+    printText(text);
 }
 
 MenuItem* MenuItem::getParent() {
@@ -15,18 +28,6 @@ void MenuItem::setParent(MenuItem* newParent) {
     parent=newParent;
   }
 
-bool SubMenuItem::update(menu_event_t event) {
-    if (submenu!=NULL) {
-        parent->goSubmenu(submenu);
-    }
-    return false; // return false to leave activation state
-};
-
-bool BackMenuItem::update(menu_event_t event) {
-    parent->leaveSubmenu();
-    return false;
-};
-
 bool ActionMenuItem::update(menu_event_t event) {
     if (callback!=NULL) {
         bool returnValue= callback(callbackArgument);
@@ -38,41 +39,54 @@ bool ActionMenuItem::update(menu_event_t event) {
 };
 
 bool ParamMenuItem::update(menu_event_t event) {
-    if ((event==MENU_LEAVE)||(event==MENU_SELECT)) {requestRedraw(); return false;} // nothing to do - just return false
+    if ((event==MENU_LEAVE)||(event==MENU_SELECT)) {
+        // editing ends: a deferred callback gets the final value now
+        parameter->commit();
+        requestRedraw();
+        return false;
+    }
     if (event==MENU_UP) {parameter->increment();    requestRedraw();}
     if (event==MENU_DOWN) {parameter->decrement();  requestRedraw();}
     
+    checkKnob();
+    return true;
+};
+
+bool ParamMenuItem::updateSteps(int16_t steps) {
+    if (steps!=0) {parameter->incrementBy(steps); requestRedraw();}
+    checkKnob();
+    return true;
+};
+
+void ParamMenuItem::checkKnob() {
     // check analog input
     if (knob!=NULL) {
         if (knob->hasChanged()) {
-            parameter->setScaledValue(knob->getValue());
+            parameter->setScaledFraction(knob->getFraction());
             requestRedraw();
         }
     }
-    return true;
 };
 
-void ParamMenuItem::getText(char* buffer) {
-    strcpy(buffer, name);
-    strcat(buffer, "=");
-    char valueBuffer[5];
-    parameter->getValueAsString(valueBuffer);
-    strcat(buffer, valueBuffer);
+void ParamMenuItem::printText(Print& out) {
+    out.print(name);
+    out.print('=');
+    parameter->printValue(out);
 }
 
 MenuItem* Menu::getCurrentItem() {
-    return items[selectedItem];
+    return getItem(selectedItem);
   };
 
-MenuItem* Menu::getItem(uint8_t index) {
+MenuItem* Menu::getItem(uint16_t index) {
     if ((index>=0)&&(index<maxCount)) 
       return items[index];
     else return NULL;
   };
   
-uint8_t Menu::getSelectedItem() {return selectedItem;};
+uint16_t Menu::getSelectedItem() {return selectedItem;};
   
-uint8_t Menu::getScrollOffset() {return scrollOffset;};
+uint16_t Menu::getScrollOffset() {return scrollOffset;};
 
 Menu* Menu::getParent() {
     return parent;
@@ -85,20 +99,64 @@ Menu* Menu::getCurrentSubmenu() {
     return currentSubmenu;
   }
 
+// navigation stacks for root menus that were not given their own, each bound to one root (NULL: free)
+static MenuNavigation defaultNavigation[MENU_NAVIGATION_ROOTS];
+static Menu* defaultNavigationOwner[MENU_NAVIGATION_ROOTS];
+
+Menu::~Menu() {
+    for (uint8_t i=0; i<MENU_NAVIGATION_ROOTS; i++) {
+        if (defaultNavigationOwner[i]==this) {
+            defaultNavigation[i].clear();
+            defaultNavigationOwner[i] = NULL;
+        }
+    }
+}
+
+bool MenuNavigation::push(Menu* menu, uint16_t selectedItem, uint16_t scrollOffset) {
+    if (depth>=MENU_NAVIGATION_DEPTH) return false;
+    frames[depth].menu = menu;
+    frames[depth].selectedItem = selectedItem;
+    frames[depth].scrollOffset = scrollOffset;
+    depth++;
+    return true;
+}
+
+bool MenuNavigation::pop(Frame& frame) {
+    if (depth==0) return false;
+    frame = frames[--depth];
+    return true;
+}
+
 void Menu::goSubmenu(Menu* submenu) {
-    currentSubmenu=submenu;
-    if (parent!=NULL) parent->goSubmenu(submenu); // recursively go to root, to set current submenu everywhere
-    submenu->setParent(this);
+    if (navigation==NULL) {
+        // take a free built-in stack: roots sharing one would pop each other's menus
+        for (uint8_t i=0; (navigation==NULL) && (i<MENU_NAVIGATION_ROOTS); i++) {
+            if (defaultNavigationOwner[i]==NULL) {
+                defaultNavigationOwner[i] = this;
+                navigation = &defaultNavigation[i];
+            }
+        }
+        if (navigation==NULL) return;
+    }
+    if (!navigation->push(currentSubmenu, currentSubmenu->selectedItem, currentSubmenu->scrollOffset)) return;
+    currentSubmenu = submenu;
+    currentSubmenu->redraw = true;
   }
 
 void Menu::leaveSubmenu() {
-    currentSubmenu=currentSubmenu->getParent();
-    if (currentSubmenu==NULL) currentSubmenu=this;
-    if (parent!=NULL) parent->leaveSubmenu(); // recursively go to root, to set current submenu everywhere
+    currentSubmenu->redraw = true;
+    if (currentSubmenu->leaveLevel()) return;
+    MenuNavigation::Frame frame;
+    if ((navigation==NULL) || !navigation->pop(frame)) return; // already at the root
+    currentSubmenu = frame.menu;
+    // restore the cursor, the menu may have been entered from somewhere else in between
+    currentSubmenu->selectedItem = frame.selectedItem;
+    currentSubmenu->scrollOffset = frame.scrollOffset;
     currentSubmenu->redraw = true;
   }
   
 void Menu::goNext() {
+    if (maxCount==0) return;
     selectedItem++;
     if (selectedItem>=maxCount) 
     if (rollover) {
@@ -111,6 +169,7 @@ void Menu::goNext() {
   };
   
 void Menu::goPrevious() {
+    if (maxCount==0) return;
     if (rollover) {
         if (selectedItem>0)  selectedItem--; else selectedItem=maxCount-1;
     } else {
@@ -120,10 +179,34 @@ void Menu::goPrevious() {
     if (selectedItem-scrollOffset>menuLines-1) scrollOffset=selectedItem-(menuLines-1);
   };
 
+void Menu::moveBy(int16_t offset) {
+    if (maxCount==0) return;
+    int32_t target = (int32_t)selectedItem + offset;
+    if (rollover) {
+        target %= maxCount;
+        if (target<0) target += maxCount;
+    } else {
+        if (target<0) target=0;
+        if (target>=maxCount) target=maxCount-1;
+    }
+    selectedItem = target;
+    if (selectedItem<scrollOffset) scrollOffset=selectedItem;
+    if (selectedItem-scrollOffset>menuLines-1) scrollOffset=selectedItem-(menuLines-1);
+  };
 
 MenuItem* Menu::navigateMenu(menu_event_t event) {
+    MENU_STATS_STAGE(STAGE_NAVIGATION);
+    if (event!=NONE) {
+        MENU_STATS_INPUT();
+        MENU_STATS_COUNT(COUNT_EVENTS, 1);
+    }
+    return handleEvent(event);
+}
+
+MenuItem* Menu::handleEvent(menu_event_t event) {
     currentSubmenu->redraw=false; 
     if (currentSubmenu->activated) {
+        MENU_STATS_STAGE(STAGE_UPDATE);
         currentSubmenu->activated = currentSubmenu->getCurrentItem()->update(event);
         currentSubmenu->redraw = currentSubmenu->getCurrentItem()->needsRedraw(); 
         return currentSubmenu->getCurrentItem();
@@ -138,10 +221,18 @@ MenuItem* Menu::navigateMenu(menu_event_t event) {
             break;
             case MENU_SELECT:
                 if (currentSubmenu->getCurrentItem()!=NULL) {
-                    // set parent to ensure correct return
-                    currentSubmenu->getCurrentItem()->setParent(currentSubmenu);
-                    currentSubmenu->activated = currentSubmenu->getCurrentItem()->update(NONE);
-                    return currentSubmenu->getCurrentItem();
+                    MenuItem* item = currentSubmenu->getCurrentItem();
+                    // submenus and back items are handled here, on the navigation stack of the root
+                    Menu* submenu = item->getSubmenu();
+                    if (submenu!=NULL) {
+                        goSubmenu(submenu);
+                    } else if (item->leavesMenu()) {
+                        leaveSubmenu();
+                    } else {
+                        MENU_STATS_STAGE(STAGE_UPDATE);
+                        currentSubmenu->activated = item->update(NONE);
+                    }
+                    return item;
                 }
             break;
             case MENU_LEAVE:
@@ -157,11 +248,63 @@ MenuItem* Menu::navigateMenu(menu_event_t event) {
     return NULL;
 }
 
-bool Menu::update(menu_event_t event) {
-    if (parent!=NULL) {
-        parent->goSubmenu(this);
+MenuItem* Menu::navigateMenu(MenuEventQueue& events) {
+    menu_event_t burst[MENU_EVENT_QUEUE_SIZE];
+    uint8_t count = 0;
+    while ((count<MENU_EVENT_QUEUE_SIZE) && events.pop(burst[count])) count++;
+    return navigateMenu(burst, count);
+}
+
+bool Menu::applySteps(int16_t steps, MenuItem*& activeItem) {
+    if (currentSubmenu->activated) {
+        MENU_STATS_STAGE(STAGE_UPDATE);
+        MenuItem* item = currentSubmenu->getCurrentItem();
+        currentSubmenu->activated = item->updateSteps(steps);
+        activeItem = item;
+        return item->needsRedraw();
     }
-    
-    return false; // return false to leave activation state
-};
+    uint16_t selected = currentSubmenu->selectedItem;
+    uint16_t offset = currentSubmenu->scrollOffset;
+    currentSubmenu->moveBy(-steps);
+    activeItem = NULL;
+    // no redraw when the cursor is held at the end of the list
+    return (currentSubmenu->selectedItem!=selected) || (currentSubmenu->scrollOffset!=offset);
+}
 
+MenuItem* Menu::navigateBy(int16_t steps) {
+    if (steps==0) return navigateMenu(NONE);
+    MENU_STATS_STAGE(STAGE_NAVIGATION);
+    MENU_STATS_INPUT();
+    MENU_STATS_COUNT(COUNT_EVENTS, 1);
+    MenuItem* activeItem = NULL;
+    currentSubmenu->redraw = applySteps(steps, activeItem);
+    return activeItem;
+}
+
+MenuItem* Menu::navigateMenu(const menu_event_t* events, uint8_t count) {
+    if (count==0) return navigateMenu(NONE);
+    MENU_STATS_STAGE(STAGE_NAVIGATION);
+    MENU_STATS_INPUT();
+    MENU_STATS_COUNT(COUNT_EVENTS, count);
+    MenuItem* activeItem = NULL;
+    bool redrawPending = false;
+    int16_t steps = 0; // MENU_UP minus MENU_DOWN events not applied yet
+    for (uint8_t i=0; i<=count; i++) {
+        if (i<count) {
+            if (events[i]==MENU_UP) {steps++; continue;}
+            if (events[i]==MENU_DOWN) {steps--; continue;}
+        }
+        // apply the folded moves before any other event (or at the end), since select/leave change what they act on
+        if (steps!=0) {
+            redrawPending |= applySteps(steps, activeItem);
+            steps = 0;
+        }
+        if (i<count) {
+            activeItem = handleEvent(events[i]);
+            redrawPending |= currentSubmenu->redraw;
+        }
+    }
+    // each call resets the flag, so keep a redraw requested by any of the events
+    currentSubmenu->redraw = redrawPending;
+    return activeItem;
+}
@@ -3,10 +3,20 @@
 #include <Arduino.h>
 #include "parameters.h"
 #include <AnalogKnob.h>
+#include "EventQueue.h"
+#include "MenuText.h"
 
 // Events to control the menu navigation. This would typically be mapped to some buttons.
 typedef enum menu_event_t {NONE, MENU_UP, MENU_DOWN, MENU_SELECT, MENU_LEAVE} menu_event_t;
 
+// number of pending menu events that can be buffered between two navigateMenu calls (power of two)
+#ifndef MENU_EVENT_QUEUE_SIZE
+#define MENU_EVENT_QUEUE_SIZE 8
+#endif
+
+// Queue of pending menu events, e.g. filled from interrupts (see InterruptButtons.h) and drained by navigateMenu.
+typedef EventQueue<menu_event_t, MENU_EVENT_QUEUE_SIZE> MenuEventQueue;
+
 class Menu;
 
  /**
@@ -21,16 +31,31 @@ class MenuItem {
 protected:
     char* name;
     bool redraw;
+    uint8_t version;
     Menu* parent;
 public:
     
     MenuItem(char* aname):
-        name(aname), parent(NULL) { };
+        name(aname), redraw(false), version(0), parent(NULL) { };
+    /** printText
+     * @brief writes the display text for this item, in one pass and without copies. Subclasses override this method.
+     * @param out: the destination, e.g. the display, Serial or a MenuTextBuffer
+     */
+    virtual void printText(Print& out);
+    
     /** getText
-     * @brief returns the display text for this item
-     * @param buffer: the destination array to write the text into (needs to be big enough to hold the text).
+     * @brief copies the display text for this item into a buffer, truncated to fit
+     * @param buffer: the destination array
+     * @param size: size of the array, including the terminating zero
      */
-    virtual void getText(char* buffer); 
+    void getText(char* buffer, uint8_t size);
+
+    /** getText
+     * @brief removed: the unbounded getText(char*) of older versions is no longer called by the displays. Deleted, so that
+     *        subclasses still overriding it fail to compile instead of silently losing their text: override printText(Print&)
+     *        and print the text there (out.print(name) instead of strcpy(buffer, name)).
+     */
+    virtual void getText(char* buffer) = delete;
     /** update
      * @brief arbitrary execution function for menu items, eg. parameter update. Subclasses should override this method.
      * @param event Button pushes to be passed to the update method
@@ -38,6 +63,14 @@ public:
      */
     virtual bool update(menu_event_t event); // 
     
+    /** updateSteps
+     * @brief update for a burst of MENU_UP/MENU_DOWN events, folded into one net count. The default calls update() once
+     *        per step; subclasses can apply all steps at once (e.g. one parameter change instead of many).
+     * @param steps number of MENU_UP minus number of MENU_DOWN events
+     * @return true if still activated, like update()
+     */
+    virtual bool updateSteps(int16_t steps);
+    
     /** needsRedraw
      * @brief return flag if this menu item has to be refreshed on the display
      * @return true when redraw is required
@@ -54,6 +87,43 @@ public:
      */
     void requestRedraw() {redraw = true;};
     
+    /** getVersion
+     * @brief change counter of the item text. Displays skip rows whose item has the same version as when it was last drawn
+     *        (and does not request a redraw). Items showing a parameter include the version of the parameter.
+     * @return version, wrapping around after 256 changes
+     */
+    virtual uint8_t getVersion() {return version;};
+    
+    /** markChanged
+     * @brief call when the text of the item changed (e.g. a new name): bumps the version and requests a redraw
+     */
+    void markChanged() {version++; redraw = true;};
+    
+    /** refresh
+     * @brief hook for items showing live values: called regularly while the item is visible (see MenuWatcher)
+     * @param now current millis()
+     * @return true if the text of the item changed
+     */
+    virtual bool refresh(uint32_t now) {return false;};
+    
+    /** getSubmenu
+     * @brief submenu that the navigation enters when this item is selected. Subclasses override this instead of navigating in update().
+     * @return the submenu, or NULL for items that are not submenus
+     */
+    virtual Menu* getSubmenu() {return NULL;};
+    
+    /** leavesMenu
+     * @brief tells the navigation to return to the enclosing menu when this item is selected
+     * @return true for "back" items
+     */
+    virtual bool leavesMenu() {return false;};
+    
+    /** getParameter
+     * @brief parameter edited by this item, e.g. for graphical displays that draw its range
+     * @return the parameter, or NULL for items without one
+     */
+    virtual Parameter* getParameter() {return NULL;};
+    
     MenuItem* getParent();
     void setParent(MenuItem* newParent);
 };
@@ -74,11 +144,10 @@ public:
     SubMenuItem(char* aname, Menu* submenu=NULL):
         MenuItem(aname),  submenu(submenu) { };
     /**
-     * @brief update method override to enter the submenu
-     * @param event: Button events for menu control
+     * @brief the submenu to enter when selected
      * @return 
      */
-    virtual bool update(menu_event_t event); 
+    virtual Menu* getSubmenu() {return submenu;};
 };
 
 /**
@@ -95,11 +164,10 @@ public:
     BackMenuItem(char* aname):
         MenuItem(aname) { };
     /**
-     * @brief update method override to enter the submenu
-     * @param event: Button events for menu control
+     * @brief selecting this item returns to the enclosing menu
      * @return 
      */
-    virtual bool update(menu_event_t event); 
+    virtual bool leavesMenu() {return true;};
 };
 
 /**
@@ -144,6 +212,8 @@ protected:
     Parameter* parameter;
     
     AnalogKnob* knob;
+    
+    void checkKnob();
 public:
     Menu* parent;
     /**
@@ -155,8 +225,61 @@ public:
     ParamMenuItem(char* aname, Parameter* parameter=NULL, AnalogKnob* knob = NULL):
         MenuItem(aname), parameter(parameter), knob(knob) { };
 
-    virtual void getText(char* buffer); // returns the display text for this item
+    virtual void printText(Print& out); // writes "name=value"
+    virtual Parameter* getParameter() {return parameter;};
+    virtual uint8_t getVersion() {return parameter!=NULL ? version+parameter->getVersion() : version;};
     virtual bool update(menu_event_t event); // arbitrary execution function for menu items, eg. parameter update
+    
+    /**
+     * @brief Changes the parameter by the net number of steps with a single update (and a single callback).
+     */
+    virtual bool updateSteps(int16_t steps);
+};
+
+// maximum nesting depth of submenus (entries of the navigation stack)
+#ifndef MENU_NAVIGATION_DEPTH
+#define MENU_NAVIGATION_DEPTH 6
+#endif
+
+// number of root menus that get a navigation stack of their own without setNavigation()
+#ifndef MENU_NAVIGATION_ROOTS
+#define MENU_NAVIGATION_ROOTS 2
+#endif
+
+/**
+ * @class MenuNavigation
+ * @file Menu.h
+ * @brief Fixed-capacity stack of the menus that were entered, with their cursor positions. It is owned by the root menu;
+ *        entering a submenu pushes and going back pops, both in constant time. Root menus without setNavigation() take one
+ *        of MENU_NAVIGATION_ROOTS built-in stacks when they first enter a submenu, and return it when destroyed.
+ */
+class MenuNavigation {
+public:
+  struct Frame {
+    Menu* menu;
+    uint16_t selectedItem;
+    uint16_t scrollOffset;
+  };
+private:
+  Frame frames[MENU_NAVIGATION_DEPTH];
+  uint8_t depth;
+public:
+  MenuNavigation(): depth(0) {};
+  
+  /**
+   * @brief Pushes a menu with its cursor position.
+   * @return false if the stack is full
+   */
+  bool push(Menu* menu, uint16_t selectedItem, uint16_t scrollOffset);
+  
+  /**
+   * @brief Pops the most recent menu.
+   * @return false if the stack is empty
+   */
+  bool pop(Frame& frame);
+  
+  uint8_t getDepth() {return depth;};
+  void clear() {depth = 0;};
 };
 
 /**
@@ -168,17 +291,21 @@ public:
  * Submenus can be cascaded as desired.
  */
 class Menu: public MenuItem {
-private:
+protected:
   bool rollover; // flag if menu should roll around at top and bottom
   MenuItem** items;
-  uint8_t selectedItem;
+  uint16_t selectedItem;
   bool activated;
   bool redraw;
-  uint8_t scrollOffset;
-  uint8_t maxCount;
+  uint16_t scrollOffset;
+  uint16_t maxCount;
   //Menu* parent;
   Menu* currentSubmenu;
+  MenuNavigation* navigation; // stack of entered menus (root menu only)
   uint8_t menuLines; //number of lines that fit on the display
+  
+  MenuItem* handleEvent(menu_event_t event); // navigateMenu without the instrumentation
+  bool applySteps(int16_t steps, MenuItem*& activeItem); // folded MENU_UP/MENU_DOWN steps, returns true if a redraw is needed
 public:
   /**
    * @brief Constructor for menu. Takes a list of pointers to menu items. 
@@ -187,32 +314,75 @@ public:
    * @param rollover activates roll-over at the top and bottom of the menu
    * @param menuLines number of lines that fit on the display. 
    */
-  Menu(MenuItem** items, uint8_t count, char* name="", bool rollover=false, uint8_t menuLines=4) :
-  MenuItem(name), items(items), selectedItem(0), activated(false), rollover(rollover), redraw(true), scrollOffset(0), maxCount(count), currentSubmenu(this), menuLines(menuLines)
+  Menu(MenuItem** items, uint16_t count, char* name="", bool rollover=false, uint8_t menuLines=4) :
+  MenuItem(name), items(items), selectedItem(0), activated(false), rollover(rollover), redraw(true), scrollOffset(0), maxCount(count), currentSubmenu(this), navigation(NULL), menuLines(menuLines)
   {}
+
+  /**
+   * @brief Returns the built-in navigation stack, if this root menu took one.
+   */
+  ~Menu();
+
   MenuItem* getCurrentItem();
   
-  MenuItem* getItem(uint8_t index);
+  /**
+   * @brief Returns a menu item of this menu. Subclasses can override this to generate items on demand.
+   * @param index Position of the item in the menu
+   * @return the item, or NULL if the index is out of range
+   */
+  virtual MenuItem* getItem(uint16_t index);
   
-  uint8_t getSelectedItem();
+  uint16_t getSelectedItem();
   
-  uint8_t getScrollOffset();
+  uint16_t getScrollOffset();
 
   Menu* getParent();
   void setParent(Menu* newParent);
 
   Menu* getCurrentSubmenu();
 
+  /**
+   * @brief Enters a submenu, remembering the current menu and cursor position on the navigation stack. Call on the root menu.
+   *        Nothing happens if MENU_NAVIGATION_DEPTH menus are already open.
+   *        Nothing happens either if the root has no stack and all MENU_NAVIGATION_ROOTS built-in stacks are taken by
+   *        other roots: give it one with setNavigation() (or raise MENU_NAVIGATION_ROOTS).
+   * @param submenu The menu to enter. The same menu can be entered from any number of places.
+   */
   void goSubmenu(Menu* submenu);
 
+  /**
+   * @brief Returns to the menu the current submenu was entered from, restoring its cursor position. Call on the root menu.
+   */
   void leaveSubmenu();
   
+  /**
+   * @brief Hook for menus with internal levels (e.g. FlashMenu): called before the navigation stack is popped.
+   * @return true if the menu went back one level by itself
+   */
+  virtual bool leaveLevel() {return false;};
+  
+  /**
+   * @brief Uses the given navigation stack for this root menu, instead of a built-in one. Each root menu needs its own.
+   */
+  void setNavigation(MenuNavigation* stack) {navigation = stack;};
+  
   void goNext();
   
   void goPrevious();
+  
+  /**
+   * @brief Moves the cursor by several items at once, with the same roll-over and scrolling rules as goNext/goPrevious.
+   * @param offset number of items, positive towards the end of the menu
+   */
+  void moveBy(int16_t offset);
 
   bool isActivated() {return activated;};
   
+  /**
+   * @brief Call when the items of the menu changed (e.g. another list is shown), so that displays draw every row again.
+   */
+  void itemsChanged() {version++; redraw = true;};
+  
   bool needsRedraw() {return redraw;};
   void doneRedraw() {redraw = false;};
   void requestRedraw() {redraw = true;};
@@ -227,13 +397,82 @@ public:
    * @return Returns the currently activated menu item, or NULL if no menu item is active.
    */
   MenuItem* navigateMenu(menu_event_t event);
+  
+  /**
+   * @brief Runs menu navigation for all events waiting in a queue, as one burst (see below). If the queue is empty,
+   *        the active menu item still gets its regular update call.
+   * @param events Queue of pending events (consumer side)
+   * @return Returns the currently activated menu item, or NULL if no menu item is active.
+   */
+  MenuItem* navigateMenu(MenuEventQueue& events);
+  
+  /**
+   * @brief Runs menu navigation for a burst of pending events. Consecutive MENU_UP/MENU_DOWN events are folded into a net
+   *        offset: one cursor move in the menu, or one updateSteps() call of the activated item (e.g. one parameter change and
+   *        callback). Other events are processed in order, and a redraw is requested once at the end if anything changed.
+   *        Note that folding applies range limits to the net result, so opposite moves in one burst cancel out.
+   * @param events Array of pending events, oldest first
+   * @param count Number of events in the array. With 0 events, the active menu item still gets its regular update call.
+   * @return Returns the currently activated menu item, or NULL if no menu item is active.
+   */
+  MenuItem* navigateMenu(const menu_event_t* events, uint8_t count);
+
+  /**
+   * @brief Runs menu navigation for a number of steps, e.g. from a RotaryEncoder: one cursor move by all steps, or one
+   *        updateSteps() call of the activated item, and at most one redraw.
+   * @param steps net number of MENU_UP (positive) or MENU_DOWN (negative) steps. With 0 steps, the active menu item still
+   *        gets its regular update call.
+   * @return Returns the currently activated menu item, or NULL if no menu item is active.
+   */
+  MenuItem* navigateBy(int16_t steps);
+
+  /**
+   * @brief a menu used as an item is entered when selected
+   * @return 
+   */
+  virtual Menu* getSubmenu() {return this;};
+};
 
 /**
-     * @brief update method override to enter the submenu
-     * @param event: Button events for menu control
-     * @return 
-     */
-    virtual bool update(menu_event_t event); 
+ * @class MenuRowCache
+ * @file Menu.h
+ * @brief What a display row was last drawn from: menu, item position, item version and cursor state. Renderers keep one per
+ *        row and skip formatting and sending a row while it is current.
+ */
+class MenuRowCache {
+private:
+  Menu* menu;
+  MenuItem* item;
+  uint16_t index;
+  uint8_t menuVersion;
+  uint8_t itemVersion;
+  uint8_t state;
+public:
+  MenuRowCache(): menu(NULL), item(NULL), index(0), menuVersion(0), itemVersion(0), state(0) {};
+  
+  /**
+   * @brief True if the row shows this item in this state, and neither the menu nor the item changed since.
+   * @param state cursor state of the row as used by the renderer (e.g. the marker character)
+   */
+  bool isCurrent(Menu* currentMenu, uint16_t position, MenuItem* currentItem, uint8_t currentState) {
+    if ((menu!=currentMenu) || (index!=position) || (item!=currentItem) || (state!=currentState)) return false;
+    if (menuVersion!=currentMenu->getVersion()) return false;
+    return (item==NULL) || (!item->needsRedraw() && (itemVersion==item->getVersion()));
+  };
+  
+  /**
+   * @brief Records what the row shows now.
+   */
+  void update(Menu* currentMenu, uint16_t position, MenuItem* currentItem, uint8_t currentState) {
+    menu = currentMenu;
+    index = position;
+    item = currentItem;
+    state = currentState;
+    menuVersion = currentMenu->getVersion();
+    itemVersion = currentItem!=NULL ? currentItem->getVersion() : 0;
+  };
+  
+  void invalidate() {menu = NULL;};
 };
 
 #endif
@@ -1,114 +1,227 @@
 #include "MenuDisplay.h"
+#include "MenuStats.h"
 
 void MenuDisplay::updateDisplay(Menu* currentMenu) {
-  if (!currentMenu->needsRedraw()) return;
-  char buffer[20];
+  updateDisplay(currentMenu, 0);
+}
+
+bool MenuDisplay::updateDisplay(Menu* currentMenu, uint16_t budgetMicros) {
+  if (currentMenu->needsRedraw() || ((pendingMenu!=NULL) && (pendingMenu!=currentMenu))) {
+    // (re)start the frame from the latest state; changes made while it is in progress request a redraw again
+    currentMenu->doneRedraw();
+    pendingMenu = currentMenu;
+    pendingLine = 0;
+  }
+  if (pendingMenu==NULL) return true;
+  MENU_STATS_STAGE(STAGE_DISPLAY);
   //display->setTextSize(1);
   //display->setTextColor(WHITE);
   //display->clear();//Display();
   //display->setFont(&FreeMonoBold9pt7b);
   display->setFont(Arial_bold_14);
-  uint8_t startIndex = currentMenu->getScrollOffset();
-  uint8_t active = currentMenu->getSelectedItem();
-  for (int i=0; i<currentMenu->getMenuLines(); i++) { 
-    display->setCursor(0,i*2);
-    //display->clearToEOL();
-    MenuItem* item = currentMenu->getItem(startIndex+i);
-    display->setInvertMode(0);
-    //display->setTextColor(WHITE, BLACK);
-    if (startIndex+i==active) {
-      //display->setCursor(0,12+i*15);
-      
-      if (currentMenu->isActivated()) {
-        display->print("O ");
-        //display->setTextColor(BLACK, WHITE);
-        //display->fillRect(15, i*15, 128, 14, WHITE);
-        display->setInvertMode(1);
-      } else {
-          display->print("> ");
-      }
+  uint32_t start = micros();
+  bool firstStep = true;
+  while (pendingLine<currentMenu->getMenuLines()) {
+    // stop when the next step is not expected to fit (but always make progress)
+    if ((budgetMicros>0) && !firstStep && (micros()-start+stepMicros>budgetMicros)) return false;
+    uint32_t stepStart = micros();
+    if (renderLine(currentMenu, pendingLine, budgetMicros>0)) pendingLine++;
+    // estimate of the next step: recent maximum, decaying slowly
+    uint32_t elapsed = micros()-stepStart;
+    if (elapsed>0xFFFF) elapsed = 0xFFFF;
+    stepMicros -= stepMicros/8;
+    if (elapsed>stepMicros) stepMicros = elapsed;
+    firstStep = false;
+  }
+  pendingMenu = NULL;
+  MENU_STATS_SHOWN();
+  //print_float(inp, 4, 2);
+  //display->display();
+  return true;
+}
+
+bool MenuDisplay::renderLine(Menu* currentMenu, uint8_t line, bool incremental) {
+  char buffer[MENU_DISPLAY_LINE_LENGTH+1];
+  uint16_t startIndex = currentMenu->getScrollOffset();
+  uint16_t active = currentMenu->getSelectedItem();
+  MenuItem* item = currentMenu->getItem(startIndex+line);
+  char marker = ' ';
+  bool invert = false;
+  if (startIndex+line==active) {
+    if (currentMenu->isActivated()) {
+      marker = 'O';
+      invert = true;
     } else {
-        display->print("  ");
+      marker = '>';
     }
-    //display->setCursor(15,12+i*15);
-    display->setCursor(12,i*2);
+  }
+  // a line that was completed from the same item version in the same state is still correct
+  bool tracked = line<MENU_DISPLAY_MAX_LINES;
+  if (tracked) {
+    if (shadowValid[line] && rowCache[line].isCurrent(currentMenu, startIndex+line, item, marker)) return true;
+    // until the line is completed, it is not known to show anything
+    rowCache[line].invalidate();
+  }
+  // items print straight into the row buffer, which truncates to the display width
+  LineBuffer text(display, buffer, sizeof(buffer), display->displayWidth()-MENU_DISPLAY_TEXT_COLUMN);
+  if (item!=NULL) {
+      item->printText(text);
+      item->doneRedraw();
+  }
+  if (!drawLine(line, marker, invert, buffer, incremental)) return false;
+  if (tracked) rowCache[line].update(currentMenu, startIndex+line, item, marker);
+  return true;
+}
+
+size_t MenuDisplay::LineBuffer::write(uint8_t c) {
+  uint16_t width = display->charWidth(c) + display->letterSpacing();
+  if (truncated || (width>widthLeft)) {
+    truncated = true;
+    return 0;
+  }
+  if (MenuTextBuffer::write(c)==0) return 0;
+  widthLeft -= width;
+  return 1;
+}
+
+void MenuDisplay::drawMarker(uint8_t row, char marker) {
+  // cursor marker, drawn non-inverted left of the text column
+  display->setInvertMode(0);
+  display->setCursor(0, row);
+  display->print(marker);
+  if (display->col()<MENU_DISPLAY_TEXT_COLUMN) display->clear(display->col(), MENU_DISPLAY_TEXT_COLUMN-1, row, row+display->fontRows()-1);
+}
+
+bool MenuDisplay::drawLine(uint8_t line, char marker, bool invert, const char* text, bool incremental) {
+  uint8_t row = line*2;
+  uint8_t rows = display->fontRows();
+  uint8_t width = display->displayWidth();
+  
+  if (line>=MENU_DISPLAY_MAX_LINES) {
+    // untracked line: plain repaint
+    drawMarker(row, marker);
+    display->setCursor(MENU_DISPLAY_TEXT_COLUMN, row);
+    display->setInvertMode(invert);
+    display->print(text);
+    display->clearToEOL();
+    display->setInvertMode(0);
+    return true;
+  }
+  
+  // without a valid shadow, nothing on the line is known; a change of invert state needs the whole text
+  char* shadow = shadowText[line];
+  if (!shadowValid[line]) shadowMarker[line] = 0;
+  if (!shadowValid[line] || (shadowInvert[line]!=invert)) {
+    shadow[0] = 0;
+    shadowStale[line] = MENU_DISPLAY_TEXT_COLUMN;
+    shadowInvert[line] = invert;
+    shadowValid[line] = true;
+  }
+  
+  // in incremental mode, the marker, each span of changed text and each chunk of the stale tail is a step of its own
+  if (shadowMarker[line]!=marker) {
+    drawMarker(row, marker);
+    shadowMarker[line] = marker;
+    columnsSent += MENU_DISPLAY_TEXT_COLUMN;
+    if (incremental) return false;
+  }
+  
+  // item text from the first difference to the shadow copy
+  uint8_t first = 0;
+  while ((text[first]!=0) && (text[first]==shadow[first])) first++;
+  if ((text[first]!=0) || (shadow[first]!=0)) {
+    // the unchanged prefix is skipped; its pixel width gives the column to continue from
+    char saved = shadow[first];
+    shadow[first] = 0;
+    uint8_t startColumn = MENU_DISPLAY_TEXT_COLUMN + display->strWidth(shadow);
+    shadow[first] = saved;
+    uint8_t oldEnd = startColumn + display->strWidth(shadow+first);
     
-    if (item!=NULL) {
-        item->getText(buffer);
-        display->print(buffer);
-        display->clearToEOL();
-        item->doneRedraw();
-    } else {
-        display->clearToEOL();
+    uint8_t count = strlen(text+first);
+    bool partial = incremental && (count>MENU_DISPLAY_SPAN_LENGTH);
+    if (partial) count = MENU_DISPLAY_SPAN_LENGTH;
+    display->setCursor(startColumn, row);
+    display->setInvertMode(invert);
+    display->write(text+first, count);
+    display->setInvertMode(0);
+    uint8_t newEnd = display->col();
+    columnsSent += newEnd-startColumn;
+    
+    // pixels of the old text beyond the new end are stale now; new text covers stale pixels
+    uint8_t stale = shadowStale[line];
+    if ((stale!=0) && (stale<newEnd)) stale = newEnd;
+    if ((oldEnd>newEnd) && ((stale==0) || (stale>newEnd))) stale = newEnd;
+    shadowStale[line] = stale;
+    memcpy(shadow+first, text+first, count);
+    shadow[first+count] = 0;
+    if (incremental && (partial || (stale!=0))) return false;
+  }
+  
+  // clear the stale tail
+  uint8_t stale = shadowStale[line];
+  if ((stale!=0) && (stale<width)) {
+    uint8_t last = width-1;
+    if (incremental && (stale+MENU_DISPLAY_CLEAR_COLUMNS-1<last)) last = stale+MENU_DISPLAY_CLEAR_COLUMNS-1;
+    display->setInvertMode(invert);
+    display->clear(stale, last, row, row+rows-1);
+    display->setInvertMode(0);
+    columnsSent += last+1-stale;
+    if (incremental && (last+1<width)) {
+      shadowStale[line] = last+1;
+      return false;
     }
   }
-  //print_float(inp, 4, 2);
-  //display->display();
-  currentMenu->doneRedraw();
+  shadowStale[line] = 0;
+  // everything that did not have to be sent, compared to repainting the whole line
+  if (columnsSent<width) bytesSaved += (uint32_t)(width-columnsSent)*rows;
+  MENU_STATS_COUNT(COUNT_ROWS, 1);
+  MENU_STATS_COUNT(COUNT_BYTES, (uint32_t)columnsSent*rows);
+  columnsSent = 0;
+  return true;
+}
+
+// field width argument of the print functions, limited to what the formatter supports
+static uint8_t fieldWidth(int padded_length) {
+  if (padded_length<0) return 0;
+  return padded_length>NUMBER_FORMAT_LENGTH ? NUMBER_FORMAT_LENGTH : padded_length;
 }
 
-#define MAX_DIGITS 10
 void MenuDisplay::print_num_padded(int32_t c, char base, int padded_length, char padding_character)
 {
-  char storage[MAX_DIGITS];
-  int32_t i = MAX_DIGITS;
-  int32_t cpos;
-  int j = 0;
-
-  cpos=abs(c);
-  do
-  {
-    i--;
-    storage[i] = cpos % base;
-    cpos = cpos / base;
-  } while((i >= 0) && (cpos > 0) );
-
-  /* Take Care of the sign (only for decimal numbers)*/
-  if(c < 0)
-  {
-    // add padding counting minus sign
-    for (j = 0; j<padded_length - (MAX_DIGITS - i) - 1; j++) {
-      display->print(padding_character);
-    }
-    display->print('-');
+  char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+  if (base==10) {
+    formatNumber(buffer, c, fieldWidth(padded_length), padding_character);
   } else {
-    // add padding
-    for (j = 0; j<padded_length - (MAX_DIGITS - i); j++) {
-      display->print(padding_character);
-    }
-  }
-  /* i is the index of the last digit calculated */
-  /* Hence, there is no need to initialize i */
-  for( ; i<MAX_DIGITS; i++)
-  {
-    display->print((int32_t)storage[i]);
+    formatUnsigned(buffer, (uint32_t)c, base, fieldWidth(padded_length), padding_character);
   }
+  display->print(buffer);
 }
 
-void MenuDisplay::print_float(float c, int before_digits, int after_digits)
+void MenuDisplay::print_hex(uint32_t c, int padded_length)
 {
-  int32_t i;
-  float num = c;
-  
-  if (c<0) 
-  {
-    display->print("-");
-    num=-c;
-  } 
-  else 
-  {
-    display->print(" ");
-  }
+  char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+  formatHex(buffer, c, fieldWidth(padded_length));
+  display->print(buffer);
+}
 
-  int32_t whole=abs(num);
-  float after=(num-(float)whole);
+void MenuDisplay::print_fixed(int32_t c, uint8_t decimals, int padded_length, char padding_character)
+{
+  char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+  formatFixed(buffer, c, decimals, fieldWidth(padded_length), padding_character);
+  display->print(buffer);
+}
 
-  print_num_padded(whole, 10, before_digits, ' ');
-  display->print("."); 
-  for (i=0; i<after_digits; i++) 
-  {
-    after*=10;
-    display->print( (int32_t)after);
-    after=after-(int32_t)after;
+void MenuDisplay::print_float(float c, int before_digits, int after_digits)
+{
+  // sign column, then the unsigned number; a point is printed even without decimals
+  char buffer[NUMBER_FORMAT_BUFFER_SIZE+2];
+  uint8_t decimals = after_digits>0 ? after_digits : 0;
+  buffer[0] = c<0 ? '-' : ' ';
+  int width = before_digits + (decimals>0 ? 1+decimals : 0);
+  uint8_t length = 1 + formatFloat(buffer+1, c<0 ? -c : c, decimals, fieldWidth(width));
+  if (decimals==0) {
+    buffer[length++] = '.';
+    buffer[length] = 0;
   }
+  display->print(buffer);
 }
@@ -19,22 +19,136 @@
 #include "SSD1306AsciiWire.h"
 
 #include "Menu.h"
+#include "NumberFormat.h"
 
 #define MAX_DIGITS 10
 
+// number of menu lines that are tracked in the shadow buffer (lines beyond are always repainted)
+#ifndef MENU_DISPLAY_MAX_LINES
+#define MENU_DISPLAY_MAX_LINES 4
+#endif
+
+// maximum number of characters of a menu line (without cursor marker)
+#ifndef MENU_DISPLAY_LINE_LENGTH
+#define MENU_DISPLAY_LINE_LENGTH 20
+#endif
+
+// incremental mode (updateDisplay with a budget): characters drawn and tail columns cleared per step
+#ifndef MENU_DISPLAY_SPAN_LENGTH
+#define MENU_DISPLAY_SPAN_LENGTH 2
+#endif
+#ifndef MENU_DISPLAY_CLEAR_COLUMNS
+#define MENU_DISPLAY_CLEAR_COLUMNS 24
+#endif
+
+// column at which the item text starts (the cursor marker is drawn left of it)
+#define MENU_DISPLAY_TEXT_COLUMN 12
+
 class MenuDisplay {
  private:
+   /**
+    * @brief Line buffer for one menu row: stops accepting characters at MENU_DISPLAY_LINE_LENGTH characters or when
+    *        the next glyph would not fit into the remaining pixel width, so items cannot overrun the row or the buffer.
+    */
+   class LineBuffer: public MenuTextBuffer {
+    private:
+      SSD1306AsciiWire* display;
+      uint16_t widthLeft;
+    public:
+      LineBuffer(SSD1306AsciiWire* display, char* buffer, uint8_t size, uint16_t width):
+      MenuTextBuffer(buffer, size), display(display), widthLeft(width) {};
+      using Print::write;
+      virtual size_t write(uint8_t c);
+   };
+   
+
    //Adafruit_SSD1306* display;
    SSD1306AsciiWire* display;
+   
+   // shadow copy of what each line currently shows on the display
+   char shadowText[MENU_DISPLAY_MAX_LINES][MENU_DISPLAY_LINE_LENGTH+1];
+   char shadowMarker[MENU_DISPLAY_MAX_LINES];
+   bool shadowInvert[MENU_DISPLAY_MAX_LINES];
+   bool shadowValid[MENU_DISPLAY_MAX_LINES];
+   uint8_t shadowStale[MENU_DISPLAY_MAX_LINES]; // column from which the rest of the line still shows old pixels (0: none)
+   MenuRowCache rowCache[MENU_DISPLAY_MAX_LINES]; // item and version each completed line was drawn from
+   uint32_t bytesSaved;
+   uint16_t columnsSent; // columns sent for the line in progress
+   
+   // frame in progress (incremental mode)
+   Menu* pendingMenu;
+   uint8_t pendingLine;
+   uint16_t stepMicros; // time the last step took, to predict the next one
+   
+   bool renderLine(Menu* currentMenu, uint8_t line, bool incremental);
+   void drawMarker(uint8_t row, char marker);
+   bool drawLine(uint8_t line, char marker, bool invert, const char* text, bool incremental);
  public:
    //MenuDisplay(Adafruit_SSD1306* display):
    MenuDisplay(SSD1306AsciiWire* display):
-   display(display) {};
+   display(display), bytesSaved(0), columnsSent(0), pendingMenu(NULL), pendingLine(0), stepMicros(0) {
+     invalidate();
+   };
 
+   /**
+    * @brief Redraws the menu if it requested a redraw. Lines whose item, version and cursor state are unchanged are skipped
+    *        without formatting the item text; of the other lines, only the parts that differ from the shadow copy of the
+    *        screen are sent to the display.
+    * @param currentMenu The menu to show (usually mainMenu.getCurrentSubmenu())
+    */
    void updateDisplay(Menu* currentMenu);
+   
+   /**
+    * @brief Incremental redraw: renders in small steps (the changed text of a line in spans of MENU_DISPLAY_SPAN_LENGTH
+    *        characters, stale pixels in chunks of MENU_DISPLAY_CLEAR_COLUMNS) until the time budget is used up, and continues
+    *        on the next call. At least one step is made per call. Lines are always rendered from the current menu state; if the menu
+    *        changed (requested a redraw, or another submenu is shown) since the frame was started, the frame restarts
+    *        from the top, where unchanged lines cost next to nothing thanks to the shadow copy.
+    * @param currentMenu The menu to show (usually mainMenu.getCurrentSubmenu())
+    * @param budgetMicros time budget for this call in microseconds (0: no limit)
+    * @return true when the display is up to date, false if lines are still pending
+    */
+   bool updateDisplay(Menu* currentMenu, uint16_t budgetMicros);
+   
+   /**
+    * @brief Forget the shadow copy, so that the next update repaints every line completely.
+    *        Call this after drawing to the display directly (e.g. from an ActionMenuItem).
+    */
+   void invalidate() {
+     memset(shadowValid, 0, sizeof(shadowValid));
+     for (uint8_t line=0; line<MENU_DISPLAY_MAX_LINES; line++) rowCache[line].invalidate();
+   };
+   
+   /**
+    * @brief Number of display RAM bytes that did not have to be sent because the shadow copy was up to date.
+    * @return bytes saved since construction or the last resetBytesSaved()
+    */
+   uint32_t getBytesSaved() {return bytesSaved;};
+   void resetBytesSaved() {bytesSaved = 0;};
 
+   /**
+    * @brief Prints a number at the cursor position, padded on the left. The field is formatted into a buffer
+    *        first and sent with one print call.
+    * @param c number to print (signed in base 10, two's complement in other bases)
+    * @param base 2..16
+    * @param padded_length minimum field width
+    * @param padding_character character used to fill the field
+    */
    void print_num_padded(int32_t c, char base, int padded_length, char padding_character);
 
+   /**
+    * @brief Prints a hexadecimal number, zero-padded to padded_length digits.
+    */
+   void print_hex(uint32_t c, int padded_length);
+
+   /**
+    * @brief Prints a fixed-point number, e.g. c=1234 with 2 decimals as "12.34". Integer arithmetic only.
+    */
+   void print_fixed(int32_t c, uint8_t decimals, int padded_length, char padding_character=' ');
+
+   /**
+    * @brief Prints a float as sign column, whole part padded to before_digits, point and after_digits decimals (rounded).
+    */
    void print_float(float c, int before_digits, int after_digits);
 };
 
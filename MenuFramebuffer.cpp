@@ -0,0 +1,190 @@
+#include "MenuFramebuffer.h"
+
+// font header layout of SSD1306Ascii (and GLCD) fonts
+#define BITMAP_FONT_FIXED_WIDTH 2
+#define BITMAP_FONT_HEIGHT 3
+#define BITMAP_FONT_FIRST_CHAR 4
+#define BITMAP_FONT_CHAR_COUNT 5
+#define BITMAP_FONT_WIDTH_TABLE 6
+
+void Bitmap::apply(uint8_t page, uint8_t x, uint8_t mask, bitmap_color_t color) {
+    uint8_t value = data[(uint16_t)page*width + x];
+    if (color==BITMAP_WHITE) value |= mask;
+    else if (color==BITMAP_BLACK) value &= ~mask;
+    else value ^= mask;
+    put(page, x, value);
+}
+
+// draws up to 8 pixels of a column, bit 0 at row y
+void Bitmap::drawBits(int16_t x, int16_t y, uint8_t bits, bitmap_color_t color) {
+    if ((x<0) || (x>=width) || (bits==0)) return;
+    if (y<0) {
+        if (y<=-8) return;
+        bits >>= -y;
+        y = 0;
+    }
+    uint8_t page = y>>3;
+    uint8_t shift = y&7;
+    if (page>=pages) return;
+    apply(page, x, bits<<shift, color);
+    if ((shift>0) && (page+1<pages)) apply(page+1, x, bits>>(8-shift), color);
+}
+
+void Bitmap::clear(bitmap_color_t color) {
+    fillRect(0, 0, width, pages*8, color);
+}
+
+void Bitmap::setPixel(int16_t x, int16_t y, bitmap_color_t color) {
+    drawBits(x, y, 1, color);
+}
+
+bool Bitmap::getPixel(int16_t x, int16_t y) {
+    if ((x<0) || (x>=width) || (y<0) || (y>=pages*8)) return false;
+    return (data[(uint16_t)(y>>3)*width + x] >> (y&7)) & 1;
+}
+
+void Bitmap::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, bitmap_color_t color) {
+    if (x<0) {w += x; x = 0;}
+    if (y<0) {h += y; y = 0;}
+    if (x+w>width) w = width-x;
+    if (y+h>pages*8) h = pages*8-y;
+    if ((w<=0) || (h<=0)) return;
+    for (uint8_t page=y>>3; page<=(y+h-1)>>3; page++) {
+        // rows of this page inside the rectangle
+        int16_t top = page*8;
+        int16_t from = y>top ? y-top : 0;
+        int16_t to = (y+h<top+8) ? y+h-top : 8;
+        uint8_t mask = (uint8_t)((0xFF << from) & (0xFF >> (8-to)));
+        for (int16_t column=x; column<x+w; column++) apply(page, column, mask, color);
+    }
+}
+
+void Bitmap::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, bitmap_color_t color) {
+    if ((w<=0) || (h<=0)) return;
+    fillRect(x, y, w, 1, color);
+    if (h>1) fillRect(x, y+h-1, w, 1, color);
+    if (h>2) {
+        fillRect(x, y+1, 1, h-2, color);
+        if (w>1) fillRect(x+w-1, y+1, 1, h-2, color);
+    }
+}
+
+void Bitmap::drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, uint8_t w, uint8_t h, bitmap_color_t color) {
+    uint8_t rows = (h+7)/8;
+    for (uint8_t r=0; r<rows; r++) {
+        // only the pixel rows inside the height of the last page
+        uint8_t mask = ((r+1==rows) && (h&7)) ? (0xFF >> (8-(h&7))) : 0xFF;
+        for (uint8_t c=0; c<w; c++) drawBits(x+c, y+8*r, pgm_read_byte(bitmap + (uint16_t)r*w + c) & mask, color);
+    }
+}
+
+void Bitmap::copy(const Bitmap& source, uint8_t x, uint8_t page) {
+    for (uint8_t p=0; (p<source.pages) && (page+p<pages); p++) {
+        const uint8_t* row = source.data + (uint16_t)p*source.width;
+        for (uint8_t c=0; (c<source.width) && (x+c<width); c++) put(page+p, x+c, row[c]);
+    }
+}
+
+uint8_t Bitmap::fontHeight() {
+    return font ? pgm_read_byte(font + BITMAP_FONT_HEIGHT) : 0;
+}
+
+uint8_t Bitmap::charWidth(uint8_t c) {
+    if (!font) return 0;
+    uint8_t firstChar = pgm_read_byte(font + BITMAP_FONT_FIRST_CHAR);
+    uint8_t count = pgm_read_byte(font + BITMAP_FONT_CHAR_COUNT);
+    if ((c<firstChar) || (c>=firstChar+count)) return 0;
+    // fonts with a size field have a width table, fixed-width fonts have a size of 0 or 1
+    uint16_t size = (pgm_read_byte(font) << 8) | pgm_read_byte(font + 1);
+    if (size>1) return pgm_read_byte(font + BITMAP_FONT_WIDTH_TABLE + c - firstChar);
+    return pgm_read_byte(font + BITMAP_FONT_FIXED_WIDTH);
+}
+
+uint16_t Bitmap::strWidth(const char* text) {
+    uint16_t total = 0;
+    while (*text) {
+        uint8_t w = charWidth(*text++);
+        if (w==0) return 0;
+        total += w + letterSpacing;
+    }
+    return total;
+}
+
+uint8_t Bitmap::drawChar(int16_t x, int16_t y, uint8_t c, bitmap_color_t color) {
+    uint8_t w = charWidth(c);
+    if (w==0) return 0;
+    uint8_t h = pgm_read_byte(font + BITMAP_FONT_HEIGHT);
+    uint8_t rows = (h+7)/8;
+    uint8_t firstChar = pgm_read_byte(font + BITMAP_FONT_FIRST_CHAR);
+    uint8_t count = pgm_read_byte(font + BITMAP_FONT_CHAR_COUNT);
+    const uint8_t* glyph = font + BITMAP_FONT_WIDTH_TABLE;
+    uint8_t index = c-firstChar;
+    uint8_t thieleShift = 0;
+    uint16_t size = (pgm_read_byte(font) << 8) | pgm_read_byte(font + 1);
+    if (size<2) {
+        glyph += (uint16_t)rows*w*index;
+    } else {
+        // variable width: glyphs follow the width table, the last page is stored bottom-aligned
+        if (h&7) thieleShift = 8-(h&7);
+        uint16_t offset = 0;
+        for (uint8_t i=0; i<index; i++) offset += pgm_read_byte(glyph + i);
+        glyph += (uint16_t)rows*offset + count;
+    }
+    for (uint8_t r=0; r<rows; r++) {
+        for (uint8_t column=0; column<w; column++) {
+            uint8_t bits = pgm_read_byte(glyph + column + r*w);
+            if (thieleShift && (r+1==rows)) bits >>= thieleShift;
+            drawBits(x+column, y+8*r, bits, color);
+        }
+    }
+    return w + letterSpacing;
+}
+
+int16_t Bitmap::drawText(int16_t x, int16_t y, const char* text, bitmap_color_t color, int16_t right) {
+    while (*text) {
+        uint8_t w = charWidth(*text);
+        if ((w==0) || (x+w>right)) break;
+        x += drawChar(x, y, *text++, color);
+    }
+    return x;
+}
+
+void SSD1306WireDriver::begin(const DevType* dev, uint8_t i2cAddr) {
+    address = i2cAddr;
+    columnOffset = dev->colOffset;
+    uint8_t sent = 0;
+    while (sent<dev->initSize) {
+        Wire.beginTransmission(address);
+        Wire.write((uint8_t)0x00);
+        for (uint8_t n=0; (n<SSD1306_DRIVER_CHUNK) && (sent<dev->initSize); n++) Wire.write(pgm_read_byte(dev->initcmds + sent++));
+        Wire.endTransmission();
+    }
+}
+
+void SSD1306WireDriver::writePage(uint8_t page, uint8_t column, const uint8_t* data, uint8_t length) {
+    column += columnOffset;
+    Wire.beginTransmission(address);
+    Wire.write((uint8_t)0x00);
+    Wire.write(SSD1306_SETSTARTPAGE | page);
+    Wire.write(SSD1306_SETLOWCOLUMN | (column & 0x0F));
+    Wire.write(SSD1306_SETHIGHCOLUMN | (column >> 4));
+    Wire.endTransmission();
+    while (length>0) {
+        uint8_t n = length<SSD1306_DRIVER_CHUNK ? length : SSD1306_DRIVER_CHUNK;
+        Wire.beginTransmission(address);
+        Wire.write((uint8_t)0x40);
+        for (uint8_t i=0; i<n; i++) Wire.write(data[i]);
+        Wire.endTransmission();
+        data += n;
+        length -= n;
+    }
+}
+
+void SSD1306AsciiDriver::writePage(uint8_t page, uint8_t column, const uint8_t* data, uint8_t length) {
+    if (length==0) return;
+    display->setInvertMode(false);
+    display->setCursor(column, page);
+    // buffered writes, the last one closes the transaction
+    for (uint8_t i=0; i+1<length; i++) display->ssd1306WriteRamBuf(data[i]);
+    display->ssd1306WriteRam(data[length-1]);
+}
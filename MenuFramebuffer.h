@@ -0,0 +1,209 @@
+#ifndef MENU_FRAMEBUFFER_H
+#define MENU_FRAMEBUFFER_H
+#include <Arduino.h>
+#include <Wire.h>
+#include "SSD1306Ascii.h"
+
+// size of the Framebuffer in pixels (1 bit per pixel: 128x64 takes 1 KB of RAM, 128x32 half of it)
+#ifndef FRAMEBUFFER_WIDTH
+#define FRAMEBUFFER_WIDTH 128
+#endif
+#ifndef FRAMEBUFFER_HEIGHT
+#define FRAMEBUFFER_HEIGHT 64
+#endif
+#define FRAMEBUFFER_PAGES (FRAMEBUFFER_HEIGHT/8)
+
+// display data bytes per I2C transaction of SSD1306WireDriver (the AVR Wire buffer holds 32 bytes including the control byte)
+#ifndef SSD1306_DRIVER_CHUNK
+#define SSD1306_DRIVER_CHUNK 31
+#endif
+
+// how pixels are drawn: set, cleared or flipped
+typedef enum bitmap_color_t {BITMAP_BLACK, BITMAP_WHITE, BITMAP_INVERT} bitmap_color_t;
+
+/**
+ * @class Bitmap
+ * @file MenuFramebuffer.h
+ * @brief 1 bit per pixel drawing surface in SSD1306 memory layout: one byte is a column of 8 pixels (LSB on top), and each
+ *        page of 8 pixel rows is stored left to right. Draws rectangles, bitmaps and text in SSD1306Ascii fonts, clipped to its size.
+ *        Bitmaps (icons) use the same layout as font glyphs and are read from PROGMEM.
+ */
+class Bitmap {
+protected:
+    uint8_t* data;
+    uint8_t width;
+    uint8_t pages;
+    uint8_t* dirtyFirst; // per page: first and last changed column (NULL: changes are not tracked)
+    uint8_t* dirtyLast;
+    const uint8_t* font;
+    uint8_t letterSpacing;
+
+    /**
+     * @brief Stores one byte, noting the column as changed if the value differs.
+     */
+    void put(uint8_t page, uint8_t x, uint8_t value) {
+        uint8_t* p = data + (uint16_t)page*width + x;
+        if (*p==value) return;
+        *p = value;
+        if (dirtyFirst!=NULL) {
+            if (x<dirtyFirst[page]) dirtyFirst[page] = x;
+            if (x>dirtyLast[page]) dirtyLast[page] = x;
+        }
+    };
+    void apply(uint8_t page, uint8_t x, uint8_t mask, bitmap_color_t color);
+    void drawBits(int16_t x, int16_t y, uint8_t bits, bitmap_color_t color);
+public:
+    /**
+     * @brief Constructor for a bitmap on existing memory.
+     * @param data width*height/8 bytes
+     * @param width width in pixels
+     * @param height height in pixels (multiple of 8)
+     */
+    Bitmap(uint8_t* data, uint8_t width, uint8_t height):
+    data(data), width(width), pages(height/8), dirtyFirst(NULL), dirtyLast(NULL), font(NULL), letterSpacing(1) {};
+
+    uint8_t getWidth() {return width;};
+    uint8_t getHeight() {return pages*8;};
+    uint8_t getPages() {return pages;};
+    const uint8_t* getData() const {return data;};
+
+    /**
+     * @brief Sets all pixels to black (or white).
+     */
+    void clear(bitmap_color_t color=BITMAP_BLACK);
+    void setPixel(int16_t x, int16_t y, bitmap_color_t color=BITMAP_WHITE);
+    bool getPixel(int16_t x, int16_t y);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, bitmap_color_t color=BITMAP_WHITE);
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, bitmap_color_t color=BITMAP_WHITE);
+
+    /**
+     * @brief Draws the set pixels of a bitmap (e.g. an icon), the others are left unchanged.
+     * @param bitmap PROGMEM data in display layout: (h+7)/8 pages of w column bytes
+     */
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, uint8_t w, uint8_t h, bitmap_color_t color=BITMAP_WHITE);
+
+    /**
+     * @brief Copies another bitmap (pixels and background) to a page-aligned position.
+     * @param page destination page (pixel row/8)
+     */
+    void copy(const Bitmap& source, uint8_t x, uint8_t page);
+
+    void setFont(const uint8_t* newFont) {font = newFont;};
+    void setLetterSpacing(uint8_t pixels) {letterSpacing = pixels;};
+    uint8_t fontHeight();
+    uint8_t charWidth(uint8_t c);
+    uint16_t strWidth(const char* text);
+
+    /**
+     * @brief Draws the set pixels of a glyph of the current font, with its top left corner at x, y.
+     * @return horizontal advance (glyph width and letter spacing), 0 for characters not in the font
+     */
+    uint8_t drawChar(int16_t x, int16_t y, uint8_t c, bitmap_color_t color=BITMAP_WHITE);
+
+    /**
+     * @brief Draws a string, stopping before the first character that would extend beyond column right.
+     * @return column after the last character drawn
+     */
+    int16_t drawText(int16_t x, int16_t y, const char* text, bitmap_color_t color=BITMAP_WHITE, int16_t right=0x7FFF);
+};
+
+/**
+ * @class Framebuffer
+ * @file MenuFramebuffer.h
+ * @brief Display-sized Bitmap that keeps track of what changed since it was last sent: for every page, the range of columns
+ *        whose bytes differ. flush() sends only these ranges, so redrawing a region with the same content costs no traffic.
+ *        The display is reached through a driver class given as template argument (no virtual calls), which provides
+ *          void writePage(uint8_t page, uint8_t column, const uint8_t* data, uint8_t length);
+ *        see SSD1306WireDriver and SSD1306AsciiDriver.
+ */
+class Framebuffer: public Bitmap {
+private:
+    uint8_t buffer[FRAMEBUFFER_PAGES*FRAMEBUFFER_WIDTH];
+    uint8_t first[FRAMEBUFFER_PAGES];
+    uint8_t last[FRAMEBUFFER_PAGES];
+    uint32_t bytesSent;
+    uint16_t writes;
+public:
+    Framebuffer(): Bitmap(buffer, FRAMEBUFFER_WIDTH, FRAMEBUFFER_HEIGHT), bytesSent(0), writes(0) {
+        memset(buffer, 0, sizeof(buffer));
+        dirtyFirst = first;
+        dirtyLast = last;
+        invalidate();
+    };
+
+    /**
+     * @brief Marks the whole buffer as changed, so that the next flush sends a full frame (e.g. after the display
+     *        was initialised or drawn to by other code).
+     */
+    void invalidate() {
+        memset(first, 0, sizeof(first));
+        memset(last, FRAMEBUFFER_WIDTH-1, sizeof(last));
+    };
+
+    bool isDirty() {
+        for (uint8_t page=0; page<FRAMEBUFFER_PAGES; page++) if (first[page]<=last[page]) return true;
+        return false;
+    };
+
+    /**
+     * @brief Sends the changed column range of changed pages to the display.
+     * @param driver display driver
+     * @param maxPages maximum number of pages to send in this call
+     * @return true when everything has been sent
+     */
+    template<class Driver> bool flush(Driver& driver, uint8_t maxPages=FRAMEBUFFER_PAGES) {
+        for (uint8_t page=0; (page<FRAMEBUFFER_PAGES) && (maxPages>0); page++) {
+            if (first[page]>last[page]) continue;
+            uint8_t length = last[page]-first[page]+1;
+            driver.writePage(page, first[page], buffer+(uint16_t)page*FRAMEBUFFER_WIDTH+first[page], length);
+            bytesSent += length;
+            writes++;
+            first[page] = 0xFF;
+            last[page] = 0;
+            maxPages--;
+        }
+        return !isDirty();
+    };
+
+    uint32_t getBytesSent() {return bytesSent;}; // display data bytes sent by flush()
+    uint16_t getWrites() {return writes;};       // column ranges sent (each costs an address command)
+    void resetCounters() {bytesSent = 0; writes = 0;};
+};
+
+/**
+ * @class SSD1306WireDriver
+ * @file MenuFramebuffer.h
+ * @brief Framebuffer driver for an SSD1306 on the Wire library: one transaction with the page and column address,
+ *        then the data in transactions of up to SSD1306_DRIVER_CHUNK bytes.
+ */
+class SSD1306WireDriver {
+private:
+    uint8_t address;
+    uint8_t columnOffset;
+public:
+    SSD1306WireDriver(): address(0x3C), columnOffset(0) {};
+
+    /**
+     * @brief Sends the initialisation sequence of the display type (Wire.begin() has to be called before).
+     * @param dev display type, e.g. &Adafruit128x64
+     * @param i2cAddr I2C address of the display
+     */
+    void begin(const DevType* dev, uint8_t i2cAddr=0x3C);
+    void writePage(uint8_t page, uint8_t column, const uint8_t* data, uint8_t length);
+};
+
+/**
+ * @class SSD1306AsciiDriver
+ * @file MenuFramebuffer.h
+ * @brief Framebuffer driver writing through an initialised SSD1306Ascii display object, e.g. an SSD1306AsciiWire shared with
+ *        text output, or an SSD1306AsciiQueued for background transmission.
+ */
+class SSD1306AsciiDriver {
+private:
+    SSD1306Ascii* display;
+public:
+    SSD1306AsciiDriver(SSD1306Ascii* display): display(display) {};
+    void writePage(uint8_t page, uint8_t column, const uint8_t* data, uint8_t length);
+};
+
+#endif
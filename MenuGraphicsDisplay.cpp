@@ -0,0 +1,69 @@
+#include "MenuGraphicsDisplay.h"
+
+// arrow shown at items that enter a submenu (4x7 pixels)
+static const uint8_t submenuIcon[] PROGMEM = {0x7F, 0x3E, 0x1C, 0x08};
+
+// width of the filled part of a value bar, for any int32 range: the differences are taken unsigned (they do not fit
+// int32 for wide ranges), and the range is scaled down until the product with the width fits 32 bits
+static int16_t barFill(int32_t value, int32_t minimum, int32_t maximum, uint8_t width) {
+  if (value<=minimum) return 0;
+  if (value>=maximum) return width;
+  uint32_t range = (uint32_t)maximum-(uint32_t)minimum;
+  uint32_t offset = (uint32_t)value-(uint32_t)minimum;
+  while (range>0xFFFFFFUL) {
+    range >>= 1;
+    offset >>= 1;
+  }
+  return (uint32_t)width*offset/range;
+}
+
+void MenuGraphicsRenderer::render(Menu* currentMenu) {
+  for (uint8_t line=0; line<currentMenu->getMenuLines(); line++) {
+    if ((line+1)*MENU_GRAPHICS_LINE_HEIGHT>FRAMEBUFFER_HEIGHT) break;
+    renderLine(currentMenu, line);
+  }
+}
+
+void MenuGraphicsRenderer::renderLine(Menu* currentMenu, uint8_t line) {
+  uint16_t index = currentMenu->getScrollOffset()+line;
+  MenuItem* item = currentMenu->getItem(index);
+  // row state: 0 normal, 1 selected, 2 activated
+  uint8_t state = 0;
+  if (index==currentMenu->getSelectedItem()) state = currentMenu->isActivated() ? 2 : 1;
+  if (rowCache[line].isCurrent(currentMenu, index, item, state)) return;
+  Bitmap row(lineData, FRAMEBUFFER_WIDTH, MENU_GRAPHICS_LINE_HEIGHT);
+  row.setFont(font);
+  row.clear();
+  if (item!=NULL) {
+    bitmap_color_t color = BITMAP_WHITE;
+    if (state!=0) {
+      if (state==2) {
+        row.drawRect(0, 0, FRAMEBUFFER_WIDTH, MENU_GRAPHICS_LINE_HEIGHT);
+      } else {
+        row.clear(BITMAP_WHITE);
+        color = BITMAP_BLACK;
+      }
+    }
+    int16_t right = FRAMEBUFFER_WIDTH-2;
+    int32_t value, minimum, maximum;
+    Parameter* parameter = item->getParameter();
+    if ((parameter!=NULL) && parameter->getRange(value, minimum, maximum) && (maximum>minimum)) {
+      right -= MENU_GRAPHICS_BAR_WIDTH;
+      int16_t barTop = (MENU_GRAPHICS_LINE_HEIGHT-6)/2;
+      int16_t fill = barFill(value, minimum, maximum, MENU_GRAPHICS_BAR_WIDTH-4);
+      row.drawRect(right+2, barTop, MENU_GRAPHICS_BAR_WIDTH, 6, color);
+      row.fillRect(right+4, barTop+2, fill, 2, color);
+    } else if (item->getSubmenu()!=NULL) {
+      right -= 6;
+      row.drawBitmap(right+2, (MENU_GRAPHICS_LINE_HEIGHT-7)/2, submenuIcon, sizeof(submenuIcon), 7, color);
+    }
+    char buffer[MENU_GRAPHICS_TEXT_LENGTH+1];
+    MenuTextBuffer text(buffer, sizeof(buffer));
+    item->printText(text);
+    row.drawText(3, (MENU_GRAPHICS_LINE_HEIGHT-row.fontHeight())/2, buffer, color, right);
+    item->doneRedraw();
+  }
+  framebuffer.copy(row, 0, line*MENU_GRAPHICS_LINE_HEIGHT/8);
+  MENU_STATS_COUNT(COUNT_ROWS, 1);
+  rowCache[line].update(currentMenu, index, item, state);
+}
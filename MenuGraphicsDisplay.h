@@ -0,0 +1,123 @@
+#ifndef MENU_GRAPHICS_DISPLAY_H
+#define MENU_GRAPHICS_DISPLAY_H
+#include <Arduino.h>
+#include "Menu.h"
+#include "MenuFramebuffer.h"
+#include "MenuStats.h"
+
+// height of a menu line in pixels (multiple of 8)
+#ifndef MENU_GRAPHICS_LINE_HEIGHT
+#define MENU_GRAPHICS_LINE_HEIGHT 16
+#endif
+
+// maximum number of characters of a menu line
+#ifndef MENU_GRAPHICS_TEXT_LENGTH
+#define MENU_GRAPHICS_TEXT_LENGTH 20
+#endif
+
+// width of the value bar drawn for items with a ranged parameter
+#ifndef MENU_GRAPHICS_BAR_WIDTH
+#define MENU_GRAPHICS_BAR_WIDTH 32
+#endif
+
+/**
+ * @class MenuGraphicsRenderer
+ * @file MenuGraphicsDisplay.h
+ * @brief Draws a menu into a Framebuffer: the selected item as an inverted bar (an outline while it is activated), a bar
+ *        showing the value of parameters with a range, and an arrow at submenus. Each line is composed in a line buffer and
+ *        copied into the framebuffer, so only pixels that really changed are marked for sending.
+ */
+class MenuGraphicsRenderer {
+protected:
+    Framebuffer framebuffer;
+    uint8_t lineData[FRAMEBUFFER_WIDTH*MENU_GRAPHICS_LINE_HEIGHT/8];
+    MenuRowCache rowCache[FRAMEBUFFER_HEIGHT/MENU_GRAPHICS_LINE_HEIGHT];
+    const uint8_t* font;
+
+    void renderLine(Menu* currentMenu, uint8_t line);
+public:
+    MenuGraphicsRenderer(): font(Arial_bold_14) {};
+
+    /**
+     * @brief Draws the lines of the menu into the framebuffer (nothing is sent yet). Lines whose item, version and cursor
+     *        state did not change since they were drawn are skipped.
+     */
+    void render(Menu* currentMenu);
+
+    /**
+     * @brief The framebuffer, e.g. for drawing from an ActionMenuItem. Changes are sent with the next update.
+     */
+    Framebuffer& getFramebuffer() {return framebuffer;};
+
+    void setFont(const uint8_t* newFont) {font = newFont;};
+
+    /**
+     * @brief Draws all lines again and sends the whole frame with the next update, e.g. after the display or the
+     *        framebuffer was drawn to directly.
+     */
+    void invalidate() {
+        framebuffer.invalidate();
+        for (uint8_t line=0; line<FRAMEBUFFER_HEIGHT/MENU_GRAPHICS_LINE_HEIGHT; line++) rowCache[line].invalidate();
+    };
+};
+
+/**
+ * @class MenuGraphicsDisplay
+ * @file MenuGraphicsDisplay.h
+ * @brief Graphical counterpart of MenuDisplay with the same update interface, so the backend is chosen at compile time:
+ *          MenuDisplay menuDisplay(&oled);                                        // text mode, no RAM for a framebuffer
+ *          MenuGraphicsDisplay<SSD1306WireDriver> menuDisplay(&driver);          // framebuffer, partial updates
+ *        Code taking the display type as a template argument works with either, without virtual calls.
+ */
+template<class Driver>
+class MenuGraphicsDisplay: public MenuGraphicsRenderer {
+private:
+    Driver* driver;
+    Menu* shownMenu;
+    uint16_t pageMicros; // time the last page took to send, to predict the next one
+public:
+    MenuGraphicsDisplay(Driver* driver): driver(driver), shownMenu(NULL), pageMicros(0) {};
+
+    /**
+     * @brief Redraws the menu into the framebuffer if it requested a redraw, then sends what changed.
+     * @param currentMenu The menu to show (usually mainMenu.getCurrentSubmenu())
+     */
+    void updateDisplay(Menu* currentMenu) {updateDisplay(currentMenu, 0);};
+
+    /**
+     * @brief Like updateDisplay(currentMenu), but sends changed pages only while the time budget lasts (at least one
+     *        per call); the rest is sent on the next call.
+     * @param budgetMicros time budget for this call in microseconds (0: no limit)
+     * @return true when the display is up to date
+     */
+    bool updateDisplay(Menu* currentMenu, uint16_t budgetMicros) {
+        bool rendered = currentMenu->needsRedraw() || (currentMenu!=shownMenu);
+        if (!rendered && !framebuffer.isDirty()) return true;
+        MENU_STATS_STAGE(STAGE_DISPLAY);
+        if (rendered) {
+            currentMenu->doneRedraw();
+            shownMenu = currentMenu;
+            render(currentMenu);
+        }
+        uint32_t start = micros();
+        bool firstPage = true;
+        while (framebuffer.isDirty()) {
+            if ((budgetMicros>0) && !firstPage && (micros()-start+pageMicros>budgetMicros)) return false;
+            uint32_t pageStart = micros();
+#if MENU_STATS
+            uint32_t sent = framebuffer.getBytesSent();
+#endif
+            framebuffer.flush(*driver, 1);
+            MENU_STATS_COUNT(COUNT_BYTES, framebuffer.getBytesSent()-sent);
+            uint32_t elapsed = micros()-pageStart;
+            if (elapsed>0xFFFF) elapsed = 0xFFFF;
+            pageMicros -= pageMicros/8;
+            if (elapsed>pageMicros) pageMicros = elapsed;
+            firstPage = false;
+        }
+        MENU_STATS_SHOWN();
+        return true;
+    };
+};
+
+#endif
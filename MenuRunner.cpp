@@ -0,0 +1,92 @@
+#include "MenuRunner.h"
+#include "MenuStats.h"
+
+MenuRunnerBase::MenuRunnerBase(Menu* menu, menu_event_t (*input)()):
+menu(menu), input(input), poll(NULL), encoder(NULL), watcher(NULL), scheduler(NULL), pauseForTasks(false),
+nextInput(0), nextFrame(0), frameStart(0), frameInterval(1000000UL/MENU_RUNNER_FPS),
+inputInterval(MENU_RUNNER_INPUT_INTERVAL), renderBudget(MENU_RUNNER_RENDER_BUDGET), drawing(false), redrawPending(true) {
+    resetCounters();
+}
+
+void MenuRunnerBase::resetCounters() {
+    frames = 0;
+    missedInputs = 0;
+    missedFrames = 0;
+    maxInputLate = 0;
+    maxFrameTime = 0;
+}
+
+bool MenuRunnerBase::tick() {
+    uint32_t now = micros();
+    int32_t late = (int32_t)(now-nextInput);
+    if (late>=0) {
+        if ((uint32_t)late>maxInputLate) maxInputLate = late;
+        if ((uint32_t)late>=inputInterval) {
+            // ticks were skipped: start a new grid instead of catching up with a burst of polls
+            missedInputs++;
+            MENU_STATS_COUNT(COUNT_MISSED, 1);
+            nextInput = now+inputInterval;
+        } else {
+            nextInput += inputInterval;
+        }
+        if (poll!=NULL) poll(events);
+        if (input!=NULL) {
+            menu_event_t event = input();
+            if (event!=NONE) events.push(event);
+        }
+        // each navigation call resets the redraw request of the menu, so the requests are collected after every step
+        latchRedraw();
+        // all events since the last poll as one burst; with none, the active item still gets its regular update
+        menu->navigateMenu(events);
+        latchRedraw();
+        if (encoder!=NULL) {
+            int16_t steps = encoder->read(menu->getCurrentSubmenu()->isActivated());
+            if (steps!=0) menu->navigateBy(steps);
+            latchRedraw();
+        }
+        if (watcher!=NULL) watcher->poll(menu->getCurrentSubmenu());
+    }
+    if (scheduler==NULL) return true;
+    scheduler->run();
+    return !pauseForTasks || (scheduler->getCount()==0);
+}
+
+void MenuRunnerBase::latchRedraw() {
+    if (menu->getCurrentSubmenu()->needsRedraw()) redrawPending = true;
+}
+
+bool MenuRunnerBase::frameDue(Menu* currentMenu) {
+    uint32_t now = micros();
+    if (currentMenu->needsRedraw()) redrawPending = true;
+    if (drawing) {
+        if (redrawPending) {
+            if (now-frameStart>frameInterval) {
+                // a late frame is finished without restarting, so that continuous input cannot starve the display:
+                // the request stays pending for the next frame
+                currentMenu->doneRedraw();
+            } else {
+                // fold the change into the frame in progress
+                currentMenu->requestRedraw();
+                redrawPending = false;
+            }
+        }
+        return true;
+    }
+    // nothing to show, or the last frame started less than a frame period ago
+    if (!redrawPending || ((int32_t)(now-nextFrame)<0)) return false;
+    redrawPending = false;
+    currentMenu->requestRedraw();
+    frameStart = now;
+    nextFrame = now+frameInterval;
+    return true;
+}
+
+void MenuRunnerBase::frameDone() {
+    frames++;
+    uint32_t elapsed = micros()-frameStart;
+    if (elapsed>maxFrameTime) maxFrameTime = elapsed;
+    if (elapsed>frameInterval) {
+        missedFrames++;
+        MENU_STATS_COUNT(COUNT_MISSED, 1);
+    }
+}
@@ -0,0 +1,187 @@
+#ifndef MENU_RUNNER_H
+#define MENU_RUNNER_H
+#include <Arduino.h>
+#include "Menu.h"
+#include "MenuTask.h"
+#include "MenuWatch.h"
+#include "RotaryEncoder.h"
+
+// time between two input polls in microseconds
+#ifndef MENU_RUNNER_INPUT_INTERVAL
+#define MENU_RUNNER_INPUT_INTERVAL 2000
+#endif
+
+// maximum number of frames per second
+#ifndef MENU_RUNNER_FPS
+#define MENU_RUNNER_FPS 25
+#endif
+
+// display time per run() call in microseconds, a frame in progress continues on the next call (keep it below the input interval)
+#ifndef MENU_RUNNER_RENDER_BUDGET
+#define MENU_RUNNER_RENDER_BUDGET 1500
+#endif
+
+/**
+ * @class MenuRunnerBase
+ * @file MenuRunner.h
+ * @brief Display independent part of MenuRunner: input tick, frame rate limit and deadline counters.
+ */
+class MenuRunnerBase {
+protected:
+    Menu* menu;
+    menu_event_t (*input)();
+    void (*poll)(MenuEventQueue& events);
+    RotaryEncoder* encoder;
+    MenuWatcher* watcher;
+    MenuScheduler* scheduler;
+    bool pauseForTasks;
+    MenuEventQueue events;
+
+    uint32_t nextInput;
+    uint32_t nextFrame;
+    uint32_t frameStart;
+    uint32_t frameInterval;
+    uint16_t inputInterval;
+    uint16_t renderBudget;
+    bool drawing;
+    bool redrawPending; // redraw requested since the last frame started (navigation resets the flag of the menu)
+
+    uint32_t frames;
+    uint16_t missedInputs;
+    uint16_t missedFrames;
+    uint32_t maxInputLate;
+    uint32_t maxFrameTime;
+
+    MenuRunnerBase(Menu* menu, menu_event_t (*input)());
+
+    /**
+     * @brief Polls the inputs and runs the navigation if the input tick is due, then gives the scheduler its slice.
+     * @return false while menu frames are paused for a running task
+     */
+    bool tick();
+
+    /**
+     * @brief Keeps a redraw request of the current submenu until a frame shows it.
+     */
+    void latchRedraw();
+
+    /**
+     * @brief Checks whether to draw: a frame is in progress, or the menu requested a redraw and the frame period has passed.
+     * @param currentMenu The menu to show
+     * @return true if updateDisplay has to be called
+     */
+    bool frameDue(Menu* currentMenu);
+
+    /**
+     * @brief Notes the completion of a frame and checks its deadline.
+     */
+    void frameDone();
+public:
+    /**
+     * @brief Additional input source filling a queue, polled on every input tick, e.g. a function calling InterruptButtons::poll.
+     */
+    void setPoll(void (*pollEvents)(MenuEventQueue& events)) {poll = pollEvents;};
+
+    /**
+     * @brief Rotary encoder read on every input tick, with acceleration while an item is activated.
+     */
+    void setEncoder(RotaryEncoder* rotaryEncoder) {encoder = rotaryEncoder;};
+
+    /**
+     * @brief Watcher refreshing live items of the current submenu after each input poll.
+     */
+    void setWatcher(MenuWatcher* menuWatcher) {watcher = menuWatcher;};
+
+    /**
+     * @brief Scheduler given a time slice on every run() call.
+     * @param menuScheduler The scheduler
+     * @param pause true if the tasks draw on the display: no menu frames are drawn while a task is running
+     */
+    void setScheduler(MenuScheduler* menuScheduler, bool pause=true) {scheduler = menuScheduler; pauseForTasks = pause;};
+
+    void setInputInterval(uint16_t micros) {inputInterval = micros;};
+    void setFrameRate(uint8_t fps) {frameInterval = 1000000UL/fps;};
+    void setRenderBudget(uint16_t micros) {renderBudget = micros;};
+
+    /**
+     * @brief True while a frame is being drawn over several run() calls.
+     */
+    bool isDrawing() {return drawing;};
+
+    /**
+     * @brief True when the display shows the latest menu state: no frame in progress and no redraw pending.
+     */
+    bool isIdle() {return !drawing && !redrawPending;};
+
+    /**
+     * @brief Number of frames completed.
+     */
+    uint32_t getFrames() {return frames;};
+
+    /**
+     * @brief Number of input polls that came one interval or more late, i.e. at least one poll was skipped.
+     */
+    uint16_t getMissedInputs() {return missedInputs;};
+
+    /**
+     * @brief Number of frames that took longer than the frame period from start to completion.
+     */
+    uint16_t getMissedFrames() {return missedFrames;};
+
+    /**
+     * @brief Longest delay of an input poll after its tick, in microseconds.
+     */
+    uint32_t getMaxInputLate() {return maxInputLate;};
+
+    /**
+     * @brief Longest time from the start to the completion of a frame, in microseconds.
+     */
+    uint32_t getMaxFrameTime() {return maxFrameTime;};
+
+    void resetCounters();
+};
+
+/**
+ * @class MenuRunner
+ * @file MenuRunner.h
+ * @brief Main loop driver with separate input and render ticks. Call run() from loop() as often as possible:
+ *          - inputs are polled on a fixed grid of MENU_RUNNER_INPUT_INTERVAL, and each poll runs the navigation
+ *          - a frame is started when the menu requested a redraw, at most MENU_RUNNER_FPS times per second, and is
+ *            drawn in slices of MENU_RUNNER_RENDER_BUDGET between the input polls
+ *        The input rate therefore does not depend on how long frames take, and inputs arriving while a frame is drawn are
+ *        folded into it (the display always renders the latest menu state). Once a frame is late, it is finished as it is and
+ *        later changes go to the next frame, so that continuous input cannot keep restarting it. A poll that comes a whole interval late
+ *        (the loop was blocked) and a frame that takes longer than the frame period are counted as missed deadlines.
+ *        The display type is a template argument (MenuDisplay or a MenuGraphicsDisplay):
+ *          MenuRunner<MenuDisplay> runner(&mainMenu, &menuDisplay, buttonEvent);
+ *          void loop() {
+ *            runner.run();
+ *          }
+ */
+template<class Display>
+class MenuRunner: public MenuRunnerBase {
+private:
+    Display* display;
+public:
+    /**
+     * @brief Constructor for a runner.
+     * @param menu The root menu
+     * @param display The display the current submenu is shown on
+     * @param input function returning the next button event (or NONE), may be NULL
+     */
+    MenuRunner(Menu* menu, Display* display, menu_event_t (*input)()=NULL): MenuRunnerBase(menu, input), display(display) {};
+
+    /**
+     * @brief Polls the inputs if the input tick is due, and continues or starts a frame. Call this from loop().
+     */
+    void run() {
+        if (!tick()) return;
+        Menu* currentMenu = menu->getCurrentSubmenu();
+        if (!frameDue(currentMenu)) return;
+        // renders the latest menu state: changes since the frame started are folded into it
+        drawing = !display->updateDisplay(currentMenu, renderBudget);
+        if (!drawing) frameDone();
+    };
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "MenuStats.h"
+
+#if MENU_STATS
+
+MenuStats::Stage MenuStats::stages[MENU_STAGES];
+uint32_t MenuStats::counters[MENU_COUNTERS];
+uint16_t MenuStats::buckets[MENU_STATS_BUCKETS];
+uint32_t MenuStats::inputTime = 0;
+MenuStageTimer* MenuStageTimer::active = NULL;
+bool MenuStats::inputPending = false;
+
+// upper limits of the histogram buckets in ms (the last bucket takes the rest)
+static const uint8_t bucketLimits[MENU_STATS_BUCKETS-1] PROGMEM = {1, 2, 5, 10, 20, 50, 100};
+
+static const char stageNames[MENU_STAGES][5] PROGMEM = {"Inp", "Nav", "Upd", "Disp"};
+static const char counterNames[MENU_COUNTERS][7] PROGMEM = {"Events", "Frames", "Rows", "Bytes", "Missed"};
+
+void MenuStats::addTime(uint8_t stage, uint32_t ticks) {
+    Stage& s = stages[stage];
+    if ((s.calls==0) || (ticks<s.minimum)) s.minimum = ticks;
+    if (ticks>s.maximum) s.maximum = ticks;
+    s.total += ticks;
+    s.calls++;
+}
+
+void MenuStats::input() {
+    if (inputPending) return;
+    inputTime = MENU_STATS_CLOCK();
+    inputPending = true;
+}
+
+void MenuStats::shown() {
+    counters[COUNT_FRAMES]++;
+    if (!inputPending) return;
+    inputPending = false;
+    uint32_t ms = (MENU_STATS_CLOCK()-inputTime)/MENU_STATS_TICKS_PER_US/1000;
+    uint8_t bucket = 0;
+    while ((bucket<MENU_STATS_BUCKETS-1) && (ms>=pgm_read_byte(&bucketLimits[bucket]))) bucket++;
+    if (buckets[bucket]<0xFFFF) buckets[bucket]++;
+}
+
+void MenuStats::reset() {
+    memset(stages, 0, sizeof(stages));
+    memset(counters, 0, sizeof(counters));
+    memset(buckets, 0, sizeof(buckets));
+    inputPending = false;
+}
+
+void MenuStats::printLine(uint8_t line, Print& out) {
+    if (line<MENU_STAGES) {
+        const Stage& s = stages[line];
+        out.print((const __FlashStringHelper*)stageNames[line]);
+        out.print(' ');
+        if (s.calls==0) {
+            out.print('-');
+            return;
+        }
+        out.print(s.minimum/MENU_STATS_TICKS_PER_US);
+        out.print('/');
+        out.print(s.total/s.calls/MENU_STATS_TICKS_PER_US);
+        out.print('/');
+        out.print(s.maximum/MENU_STATS_TICKS_PER_US);
+        return;
+    }
+    line -= MENU_STAGES;
+    if (line<MENU_COUNTERS) {
+        out.print((const __FlashStringHelper*)counterNames[line]);
+        out.print(' ');
+        out.print(counters[line]);
+        return;
+    }
+    line -= MENU_COUNTERS;
+    if (line<MENU_STATS_BUCKETS-1) {
+        out.print(F("<"));
+        out.print(pgm_read_byte(&bucketLimits[line]));
+    } else {
+        out.print(F(">="));
+        out.print(pgm_read_byte(&bucketLimits[MENU_STATS_BUCKETS-2]));
+    }
+    out.print(F("ms "));
+    out.print(buckets[line]);
+}
+
+void MenuStats::dump(Print& out) {
+    out.println(F("stage min/mean/max us"));
+    for (uint8_t line=0; line<getLines(); line++) {
+        printLine(line, out);
+        out.println();
+    }
+}
+
+#endif
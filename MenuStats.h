@@ -0,0 +1,123 @@
+#ifndef MENU_STATS_H
+#define MENU_STATS_H
+#include <Arduino.h>
+
+// instrumentation of the menu stages: 0 (default) compiles all hooks to nothing, 1 records timing and counters
+#ifndef MENU_STATS
+#define MENU_STATS 0
+#endif
+
+// time source of the instrumentation and its ticks per microsecond, e.g. a cycle counter on ARM:
+//   #define MENU_STATS_CLOCK() (DWT->CYCCNT)
+//   #define MENU_STATS_TICKS_PER_US (F_CPU/1000000)
+#ifndef MENU_STATS_CLOCK
+#define MENU_STATS_CLOCK() micros()
+#define MENU_STATS_TICKS_PER_US 1
+#endif
+
+// stages of a loop that are timed
+typedef enum menu_stage_t {STAGE_INPUT, STAGE_NAVIGATION, STAGE_UPDATE, STAGE_DISPLAY, MENU_STAGES} menu_stage_t;
+
+// counted quantities
+typedef enum menu_counter_t {COUNT_EVENTS, COUNT_FRAMES, COUNT_ROWS, COUNT_BYTES, COUNT_MISSED, MENU_COUNTERS} menu_counter_t;
+
+// buckets of the input-to-screen latency histogram: below 1, 2, 5, 10, 20, 50, 100 ms, and 100 ms or more
+#define MENU_STATS_BUCKETS 8
+
+#if MENU_STATS
+
+/**
+ * @class MenuStats
+ * @file MenuStats.h
+ * @brief Instrumentation of the menu hot path, enabled with MENU_STATS 1. The library records
+ *          - per stage (input polling, navigation, item updates, display updates): calls and min/mean/max time, not
+ *            counting the time of stages nested in it
+ *          - counters: input events, frames completed, rows drawn, display bytes sent, deadlines missed by a MenuRunner
+ *          - a histogram of the latency from an input event to the end of the next completed frame
+ *        through the MENU_STATS_... hooks below, which are empty when MENU_STATS is 0. Show the numbers with a
+ *        MenuStatsMenu, or print them with dump().
+ */
+class MenuStats {
+public:
+    struct Stage {
+        uint32_t calls;
+        uint32_t total; // ticks
+        uint32_t minimum;
+        uint32_t maximum;
+    };
+private:
+    static Stage stages[MENU_STAGES];
+    static uint32_t counters[MENU_COUNTERS];
+    static uint16_t buckets[MENU_STATS_BUCKETS];
+    static uint32_t inputTime;
+    static bool inputPending;
+public:
+    static void addTime(uint8_t stage, uint32_t ticks);
+    static void count(uint8_t counter, uint32_t amount) {counters[counter] += amount;};
+    /**
+     * @brief Notes an input event. The latency is measured from the first event not yet shown.
+     */
+    static void input();
+    /**
+     * @brief Notes a completed frame: the pending input, if any, is now visible.
+     */
+    static void shown();
+    static void reset();
+
+    static const Stage& getStage(uint8_t stage) {return stages[stage];};
+    static uint32_t getCounter(uint8_t counter) {return counters[counter];};
+    static uint16_t getBucket(uint8_t bucket) {return buckets[bucket];};
+
+    /**
+     * @brief Number of text lines printLine() provides.
+     */
+    static uint8_t getLines() {return MENU_STAGES + MENU_COUNTERS + MENU_STATS_BUCKETS;};
+    /**
+     * @brief Prints one line of the statistics, e.g. "Disp 95/410/2300" (min/mean/max us) or "<=5ms 12".
+     */
+    static void printLine(uint8_t line, Print& out);
+    /**
+     * @brief Prints all lines, e.g. to Serial.
+     */
+    static void dump(Print& out);
+};
+
+/**
+ * @brief Times the rest of the enclosing scope as a stage. Stage times are exclusive: the time of a stage timed inside
+ *        another one (e.g. an item update during navigation) is only counted for the inner stage.
+ */
+class MenuStageTimer {
+private:
+    static MenuStageTimer* active; // innermost running timer
+    MenuStageTimer* outer;
+    uint32_t nested; // ticks of inner stages
+    uint32_t start;
+    uint8_t stage;
+public:
+    MenuStageTimer(uint8_t stage): outer(active), nested(0), stage(stage) {
+        active = this;
+        start = MENU_STATS_CLOCK();
+    };
+    ~MenuStageTimer() {
+        uint32_t elapsed = MENU_STATS_CLOCK()-start;
+        MenuStats::addTime(stage, elapsed-nested);
+        active = outer;
+        if (outer!=NULL) outer->nested += elapsed;
+    };
+};
+
+#define MENU_STATS_STAGE(stage) MenuStageTimer menuStageTimer(stage)
+#define MENU_STATS_COUNT(counter, amount) MenuStats::count(counter, amount)
+#define MENU_STATS_INPUT() MenuStats::input()
+#define MENU_STATS_SHOWN() MenuStats::shown()
+
+#else
+
+#define MENU_STATS_STAGE(stage)
+#define MENU_STATS_COUNT(counter, amount)
+#define MENU_STATS_INPUT()
+#define MENU_STATS_SHOWN()
+
+#endif
+
+#endif
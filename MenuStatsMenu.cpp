@@ -0,0 +1,16 @@
+#include "MenuStatsMenu.h"
+
+#if MENU_STATS
+
+void MenuStatsMenu::printStatsLine(uint16_t index, Print& out, void* argument) {
+    if (index<MenuStats::getLines()) MenuStats::printLine(index, out);
+    else out.print(F("Reset"));
+}
+
+bool MenuStatsMenu::selectStatsLine(uint16_t index, void* argument) {
+    if (index>=MenuStats::getLines()) MenuStats::reset();
+    ((MenuStatsMenu*)argument)->itemsChanged();
+    return false;
+}
+
+#endif
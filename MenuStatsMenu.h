@@ -0,0 +1,35 @@
+#ifndef MENU_STATS_MENU_H
+#define MENU_STATS_MENU_H
+#include <Arduino.h>
+#include "MenuStats.h"
+#include "VirtualMenu.h"
+
+#if MENU_STATS
+
+/**
+ * @class MenuStatsMenu
+ * @file MenuStatsMenu.h
+ * @brief Diagnostics submenu listing the MenuStats lines, and "Reset" at the end. The numbers are sampled when the menu
+ *        is entered and whenever a line is selected (selecting "Reset" clears them), so that showing the statistics
+ *        does not keep redrawing itself.
+ */
+class MenuStatsMenu: public VirtualMenu {
+private:
+    static void printStatsLine(uint16_t index, Print& out, void* argument);
+    static bool selectStatsLine(uint16_t index, void* argument);
+public:
+    MenuStatsMenu(char* name="Diagnostics", uint8_t menuLines=4):
+    VirtualMenu(MenuStats::getLines()+1, printStatsLine, selectStatsLine, this, name, false, menuLines) {};
+
+    /**
+     * @brief Called when the menu is entered: samples the numbers again.
+     */
+    virtual Menu* getSubmenu() {
+        itemsChanged();
+        return this;
+    };
+};
+
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+#include "MenuTask.h"
+
+bool MenuScheduler::start(MenuTask* task) {
+    if (task->state==TASK_RUNNING) return true;
+    if (count>=MENU_SCHEDULER_TASKS) return false;
+    task->resumePoint = 0;
+    task->startTime = millis();
+    task->state = TASK_RUNNING;
+    tasks[count++] = task;
+    task->begin();
+    return true;
+}
+
+void MenuScheduler::stop(MenuTask* task) {
+    for (uint8_t i=0; i<count; i++) {
+        if (tasks[i]==task) {
+            finish(i, TASK_STOPPED);
+            return;
+        }
+    }
+}
+
+void MenuScheduler::finish(uint8_t index, task_state_t reason) {
+    MenuTask* task = tasks[index];
+    count--;
+    for (uint8_t i=index; i<count; i++) tasks[i] = tasks[i+1];
+    task->state = reason;
+    task->end(reason);
+}
+
+void MenuScheduler::run() {
+    uint8_t i = 0;
+    while (i<count) {
+        MenuTask* task = tasks[i];
+        if ((task->timeout>0) && (millis()-task->startTime>=task->timeout)) {
+            finish(i, TASK_TIMEOUT);
+            continue;
+        }
+        task->sliceEnd = micros()+task->sliceMicros;
+        task_result_t result;
+        do {
+            result = task->step();
+        } while ((result==TASK_CONTINUE) && task->isRunning() && task->timeLeft());
+        if ((int32_t)(micros()-task->sliceEnd)>(int32_t)task->sliceMicros) overruns++;
+        if ((i>=count) || (tasks[i]!=task)) continue; // the task stopped itself
+        if (result==TASK_FINISHED) {
+            finish(i, TASK_DONE);
+            continue;
+        }
+        i++;
+    }
+}
+
+bool TaskMenuItem::update(menu_event_t event) {
+    if (!started) {
+        // selected: start the task
+        if (!scheduler->start(task) || background) {
+            requestRedraw();
+            return false;
+        }
+        started = true;
+        return true;
+    }
+    if ((event==MENU_SELECT) || (event==MENU_LEAVE)) scheduler->stop(task);
+    if (!task->isRunning()) {
+        started = false;
+        requestRedraw();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,162 @@
+#ifndef MENU_TASK_H
+#define MENU_TASK_H
+#include <Arduino.h>
+#include "Menu.h"
+
+// maximum number of tasks a MenuScheduler runs at the same time
+#ifndef MENU_SCHEDULER_TASKS
+#define MENU_SCHEDULER_TASKS 4
+#endif
+
+// result of one MenuTask::step() call
+typedef enum task_result_t {TASK_CONTINUE, TASK_YIELD, TASK_FINISHED} task_result_t;
+
+// life cycle of a task
+typedef enum task_state_t {TASK_IDLE, TASK_RUNNING, TASK_DONE, TASK_STOPPED, TASK_TIMEOUT} task_state_t;
+
+/*
+ * Stackless coroutine helpers for MenuTask::step(). Local variables do not survive a yield, keep the state in members.
+ *
+ *   task_result_t step() {
+ *     TASK_BEGIN();
+ *     for (i=0; i<100; i++) {
+ *       moveMotor(i);
+ *       TASK_WAIT_UNTIL(motorReady()); // other tasks, input and display run meanwhile
+ *     }
+ *     TASK_END();
+ *   }
+ */
+#define TASK_BEGIN() switch (resumePoint) { case 0:
+// continue with the next statement on the next tick
+#define TASK_YIELD() do { resumePoint = __LINE__; return TASK_YIELD; case __LINE__:; } while (0)
+// continue with the next statement right away if the slice has time left, otherwise on the next tick
+#define TASK_PAUSE() do { resumePoint = __LINE__; return TASK_CONTINUE; case __LINE__:; } while (0)
+// check the condition once per tick until it becomes true
+#define TASK_WAIT_UNTIL(condition) do { resumePoint = __LINE__; case __LINE__: if (!(condition)) return TASK_YIELD; } while (0)
+#define TASK_END() } resumePoint = 0; return TASK_FINISHED
+
+class MenuScheduler;
+
+/**
+ * @class MenuTask
+ * @file MenuTask.h
+ * @brief Resumable piece of work run by a MenuScheduler, e.g. a calibration routine or a motor move. Instead of looping until
+ *        it is done, a task does a bit of work per step() call and returns; the scheduler calls it again while its time slice
+ *        lasts, and the menu input and display keep running between slices. Write step() as a state machine, or with the
+ *        TASK_BEGIN/TASK_YIELD/TASK_END macros.
+ */
+class MenuTask {
+protected:
+    uint16_t resumePoint;  // position in step() for the TASK_* macros
+    uint16_t sliceMicros;  // time budget per tick
+    uint32_t timeout;      // maximum run time in milliseconds (0: unlimited)
+    uint32_t startTime;
+    uint32_t sliceEnd;
+    task_state_t state;
+
+    friend class MenuScheduler;
+public:
+    /**
+     * @brief Constructor for a task.
+     * @param sliceMicros time budget per tick in microseconds. step() is called repeatedly while it returns TASK_CONTINUE and
+     *        the budget is not used up.
+     * @param timeout deadline in milliseconds after start; the task is stopped when it has not finished by then (0: no deadline)
+     */
+    MenuTask(uint16_t sliceMicros=1000, uint32_t timeout=0):
+    resumePoint(0), sliceMicros(sliceMicros), timeout(timeout), startTime(0), sliceEnd(0), state(TASK_IDLE) {};
+
+    /**
+     * @brief Does the next piece of work. Keep each call short (well below the slice budget).
+     * @return TASK_CONTINUE to be called again in this slice, TASK_YIELD to wait for the next tick, TASK_FINISHED when done
+     */
+    virtual task_result_t step() = 0;
+
+    /**
+     * @brief Called when the task is started.
+     */
+    virtual void begin() {};
+
+    /**
+     * @brief Called when the task has ended.
+     * @param reason TASK_DONE, TASK_STOPPED or TASK_TIMEOUT
+     */
+    virtual void end(task_state_t reason) {};
+
+    /**
+     * @brief True while the current slice has budget left. Long loops inside step() can check this.
+     */
+    bool timeLeft() {return (int32_t)(sliceEnd-micros())>0;};
+
+    task_state_t getState() {return state;};
+    bool isRunning() {return state==TASK_RUNNING;};
+    void setTimeout(uint32_t ms) {timeout = ms;};
+    void setSlice(uint16_t micros) {sliceMicros = micros;};
+};
+
+/**
+ * @class MenuScheduler
+ * @file MenuTask.h
+ * @brief Small cooperative scheduler for MenuTasks. Call run() once per main loop iteration, between input handling
+ *        (navigateMenu) and rendering (updateDisplay): every running task gets one time slice, round robin.
+ */
+class MenuScheduler {
+private:
+    MenuTask* tasks[MENU_SCHEDULER_TASKS];
+    uint8_t count;
+    uint16_t overruns;
+
+    void finish(uint8_t index, task_state_t reason);
+public:
+    MenuScheduler(): count(0), overruns(0) {};
+
+    /**
+     * @brief Starts a task from the beginning. A task that is already running is left alone.
+     * @return false if MENU_SCHEDULER_TASKS tasks are already running
+     */
+    bool start(MenuTask* task);
+
+    /**
+     * @brief Stops a running task (its end() is called with TASK_STOPPED).
+     */
+    void stop(MenuTask* task);
+
+    /**
+     * @brief Runs one slice of every task.
+     */
+    void run();
+
+    uint8_t getCount() {return count;};
+
+    /**
+     * @brief Number of slices that ended more than the slice budget late, i.e. a step() call took too long.
+     */
+    uint16_t getOverruns() {return overruns;};
+};
+
+/**
+ * @class TaskMenuItem
+ * @file MenuTask.h
+ * @brief Menu item starting a MenuTask when selected. The item stays active while the task runs and stops it on
+ *        MENU_SELECT or MENU_LEAVE. A background item returns to the menu right away and lets the task run on.
+ */
+class TaskMenuItem: public MenuItem {
+protected:
+    MenuTask* task;
+    MenuScheduler* scheduler;
+    bool background;
+    bool started;
+public:
+    /**
+     * @brief Constructor for TaskMenuItem.
+     * @param aname The name of this menu item
+     * @param task The task to run
+     * @param scheduler The scheduler running the task
+     * @param background true to return to the menu while the task keeps running
+     */
+    TaskMenuItem(char* aname, MenuTask* task, MenuScheduler* scheduler, bool background=false):
+    MenuItem(aname), task(task), scheduler(scheduler), background(background), started(false) {};
+
+    virtual bool update(menu_event_t event);
+};
+
+#endif
@@ -0,0 +1,11 @@
+#include "MenuText.h"
+
+size_t MenuTextBuffer::write(uint8_t c) {
+    if (length+1>=size) {
+        truncated = true;
+        return 0;
+    }
+    buffer[length++] = c;
+    buffer[length] = 0;
+    return 1;
+}
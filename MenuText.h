@@ -0,0 +1,50 @@
+#ifndef MENU_TEXT_H
+#define MENU_TEXT_H
+#include <Arduino.h>
+#include <Print.h>
+
+/**
+ * @class MenuTextBuffer
+ * @file MenuText.h
+ * @brief Bounded Print sink writing into a fixed char array. Menu items print their text into any Print (the display,
+ *        Serial, or this buffer); characters that do not fit are dropped, and the buffer is always zero-terminated.
+ */
+class MenuTextBuffer: public Print {
+protected:
+    char* buffer;
+    uint8_t size;
+    uint8_t length;
+    bool truncated;
+public:
+    /**
+     * @brief Constructor for a text buffer.
+     * @param buffer destination array
+     * @param size size of the array, including the terminating zero
+     */
+    MenuTextBuffer(char* buffer, uint8_t size):
+    buffer(buffer), size(size), length(0), truncated(false) {
+        if (size>0) buffer[0] = 0;
+    };
+
+    using Print::write;
+    /**
+     * @brief Appends a character if there is room left.
+     * @return 1 if the character was stored, 0 if it was dropped
+     */
+    virtual size_t write(uint8_t c);
+
+    /**
+     * @brief Empties the buffer for reuse.
+     */
+    void clear() {length = 0; truncated = false; if (size>0) buffer[0] = 0;};
+
+    const char* getText() {return buffer;};
+    uint8_t getLength() {return length;};
+
+    /**
+     * @brief true if characters were dropped since construction or the last clear()
+     */
+    bool isTruncated() {return truncated;};
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include "MenuTrace.h"
+
+void MenuTraceRecorder::begin() {
+    out->write('M');
+    out->write('T');
+    out->write((uint8_t)MENU_TRACE_VERSION);
+    bytes = 3;
+    lastTime = millis();
+}
+
+void MenuTraceRecorder::writeTag(uint8_t tag) {
+    uint32_t now = millis();
+    uint32_t delta = now-lastTime;
+    lastTime = now;
+    out->write(tag);
+    bytes++;
+    // LEB128: 7 bits per byte, low bits first, high bit set if more bytes follow
+    do {
+        uint8_t b = delta & 0x7F;
+        delta >>= 7;
+        if (delta!=0) b |= 0x80;
+        out->write(b);
+        bytes++;
+    } while (delta!=0);
+}
+
+void MenuTraceRecorder::writeWord(uint16_t word) {
+    out->write((uint8_t)(word & 0xFF));
+    out->write((uint8_t)(word >> 8));
+    bytes += 2;
+}
+
+menu_event_t MenuTraceRecorder::record(menu_event_t event) {
+    if (event!=NONE) writeTag((TRACE_EVENT << 4) | event);
+    return event;
+}
+
+int16_t MenuTraceRecorder::recordSteps(int16_t steps) {
+    if (steps!=0) {
+        writeTag(TRACE_STEPS << 4);
+        writeWord(steps);
+    }
+    return steps;
+}
+
+void MenuTraceRecorder::recordAnalog(uint8_t channel, uint16_t value) {
+    writeTag((TRACE_ANALOG << 4) | (channel & 0x0F));
+    writeWord(value);
+}
+
+MenuTraceReader::MenuTraceReader(const uint8_t* data, uint32_t length):
+data(data), length(length), position(0), time(0) {
+    valid = (length>=3) && (data[0]=='M') && (data[1]=='T') && (data[2]==MENU_TRACE_VERSION);
+    rewind();
+}
+
+bool MenuTraceReader::next(menu_trace_record_t& record) {
+    if (position>=length) return false;
+    uint8_t tag = data[position++];
+    uint32_t delta = 0;
+    uint8_t shift = 0;
+    uint8_t b;
+    do {
+        if ((position>=length) || (shift>28)) return false;
+        b = data[position++];
+        delta |= (uint32_t)(b & 0x7F) << shift;
+        shift += 7;
+    } while (b & 0x80);
+    time += delta;
+    record.time = time;
+    record.kind = tag >> 4;
+    record.arg = tag & 0x0F;
+    record.value = 0;
+    if ((record.kind==TRACE_STEPS) || (record.kind==TRACE_ANALOG)) {
+        if (position+2>length) return false;
+        uint16_t word = data[position] | ((uint16_t)data[position+1] << 8);
+        position += 2;
+        record.value = (record.kind==TRACE_STEPS) ? (int32_t)(int16_t)word : (int32_t)word;
+    } else if (record.kind!=TRACE_EVENT) {
+        return false; // unknown record
+    }
+    return true;
+}
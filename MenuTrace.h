@@ -0,0 +1,97 @@
+#ifndef MENU_TRACE_H
+#define MENU_TRACE_H
+#include <Arduino.h>
+#include "Menu.h"
+
+// version byte of the trace format
+#define MENU_TRACE_VERSION 1
+
+// kinds of trace records
+typedef enum menu_trace_kind_t {TRACE_EVENT, TRACE_STEPS, TRACE_ANALOG} menu_trace_kind_t;
+
+// one decoded trace record
+typedef struct menu_trace_record_t {
+    uint32_t time;   // milliseconds since the start of the recording
+    uint8_t kind;    // menu_trace_kind_t
+    uint8_t arg;     // TRACE_EVENT: the menu_event_t, TRACE_ANALOG: the analog channel
+    int32_t value;   // TRACE_STEPS: the steps, TRACE_ANALOG: the ADC value
+} menu_trace_record_t;
+
+/**
+ * @class MenuTraceRecorder
+ * @file MenuTrace.h
+ * @brief Records the input of a running menu into a compact binary trace, e.g. over Serial or into a file, so that a
+ *        session from the field can be replayed on the host (see extras/host/replay). Wrap the inputs of the loop:
+ *          mainMenu.navigateMenu(trace.record(buttonEvent()));
+ *        The trace starts with "MT" and the version byte, followed by one record per input:
+ *          tag byte (kind << 4 | event or channel), time since the previous record in ms (LEB128, 1 byte below 128 ms),
+ *          then for steps an int16 and for analog values a uint16 (little endian)
+ *        so a button push costs 2 bytes.
+ */
+class MenuTraceRecorder {
+private:
+    Print* out;
+    uint32_t lastTime;
+    uint32_t bytes;
+
+    void writeTag(uint8_t tag);
+    void writeWord(uint16_t word);
+public:
+    MenuTraceRecorder(Print* out): out(out), lastTime(0), bytes(0) {};
+
+    /**
+     * @brief Writes the header; the times of the records count from here.
+     */
+    void begin();
+
+    /**
+     * @brief Records a menu event (NONE is not recorded).
+     * @return the event, to pass it on to navigateMenu
+     */
+    menu_event_t record(menu_event_t event);
+
+    /**
+     * @brief Records steps, e.g. of a RotaryEncoder (0 is not recorded).
+     * @return the steps, to pass them on to navigateBy
+     */
+    int16_t recordSteps(int16_t steps);
+
+    /**
+     * @brief Records an analog value, e.g. knob.getFiltered() whenever knob.hasChanged().
+     * @param channel analog input (0..15)
+     */
+    void recordAnalog(uint8_t channel, uint16_t value);
+
+    uint32_t getBytes() {return bytes;};
+};
+
+/**
+ * @class MenuTraceReader
+ * @file MenuTrace.h
+ * @brief Decodes a trace written by MenuTraceRecorder from memory.
+ */
+class MenuTraceReader {
+private:
+    const uint8_t* data;
+    uint32_t length;
+    uint32_t position;
+    uint32_t time;
+    bool valid;
+public:
+    MenuTraceReader(const uint8_t* data, uint32_t length);
+
+    /**
+     * @brief true if the data starts with a trace header of this version.
+     */
+    bool isValid() {return valid;};
+
+    /**
+     * @brief Decodes the next record.
+     * @return false at the end of the trace or at a truncated record
+     */
+    bool next(menu_trace_record_t& record);
+
+    void rewind() {position = valid ? 3 : length; time = 0;};
+};
+
+#endif
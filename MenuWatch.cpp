@@ -0,0 +1,52 @@
+#include "MenuWatch.h"
+
+int32_t WatchMenuItem::read() {
+    if (getter!=NULL) return getter(getterArgument);
+    int32_t value = 0;
+    // multi-byte variables may be written by an interrupt
+    noInterrupts();
+    if (variable32!=NULL) value = *variable32;
+    else if (variable16!=NULL) value = *variable16;
+    interrupts();
+    return value;
+}
+
+void WatchMenuItem::printText(Print& out) {
+    char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    formatFixed(buffer, shown, decimals);
+    out.print(name);
+    out.print('=');
+    out.print(buffer);
+}
+
+bool WatchMenuItem::refresh(uint32_t now) {
+    if (sampled && ((uint16_t)((uint16_t)now-lastSample)<refreshMillis)) return false;
+    lastSample = now;
+    int32_t value = read();
+    // distance in unsigned arithmetic, which cannot overflow
+    uint32_t distance = (value>shown) ? (uint32_t)value-(uint32_t)shown : (uint32_t)shown-(uint32_t)value;
+    bool first = !sampled;
+    sampled = true;
+    if ((distance==0) || (!first && (distance<threshold))) return false;
+    shown = value;
+    markChanged();
+    return true;
+}
+
+bool MenuWatcher::poll(Menu* currentMenu) {
+    uint32_t now = millis();
+    if (now-lastPoll<interval) return false;
+    lastPoll = now;
+    bool changed = false;
+    uint16_t first = currentMenu->getScrollOffset();
+    for (uint8_t line=0; line<currentMenu->getMenuLines(); line++) {
+        MenuItem* item = currentMenu->getItem(first+line);
+        if (item==NULL) break;
+        changed |= item->refresh(now);
+    }
+    if (changed) {
+        currentMenu->requestRedraw();
+        redraws++;
+    }
+    return changed;
+}
@@ -0,0 +1,112 @@
+#ifndef MENU_WATCH_H
+#define MENU_WATCH_H
+#include <Arduino.h>
+#include "Menu.h"
+#include "NumberFormat.h"
+
+// minimum time between two redraws caused by watch items, in milliseconds
+#ifndef MENU_WATCH_INTERVAL
+#define MENU_WATCH_INTERVAL 100
+#endif
+
+/**
+ * @class WatchMenuItem
+ * @file MenuWatch.h
+ * @brief Read-only menu item showing a live value as "name=value", e.g. a sensor reading or a counter. The value is read
+ *        from a variable or a getter function at most every refreshMillis, and the item only asks for a redraw when the value
+ *        moved by at least the threshold since it was last shown. Values are integers, shown with a fixed number of decimals
+ *        (e.g. 1234 with 2 decimals as "12.34"). Sampling is driven by a MenuWatcher, only while the item is visible.
+ */
+class WatchMenuItem: public MenuItem {
+protected:
+    volatile int32_t* variable32;
+    volatile int16_t* variable16;
+    int32_t (*getter)(void*);
+    void* getterArgument;
+    int32_t shown;           // value currently shown
+    uint16_t lastSample;     // time of the last sample (low 16 bits of millis())
+    uint16_t refreshMillis;
+    uint16_t threshold;
+    uint8_t decimals;
+    bool sampled;
+
+    int32_t read();
+public:
+    /**
+     * @brief Watch item bound to a 32 bit variable (may be changed by an interrupt).
+     * @param aname Name shown before the value
+     * @param variable The variable to show
+     * @param refreshMillis minimum time between two samples (up to 65535 ms)
+     * @param threshold minimum change of the value that is shown (1: every change)
+     * @param decimals number of decimal places the value is shown with
+     */
+    WatchMenuItem(char* aname, volatile int32_t* variable, uint16_t refreshMillis=250, uint16_t threshold=1, uint8_t decimals=0):
+    MenuItem(aname), variable32(variable), variable16(NULL), getter(NULL), getterArgument(NULL), shown(0), lastSample(0),
+    refreshMillis(refreshMillis), threshold(threshold), decimals(decimals), sampled(false) {};
+
+    /**
+     * @brief Watch item bound to a 16 bit variable.
+     */
+    WatchMenuItem(char* aname, volatile int16_t* variable, uint16_t refreshMillis=250, uint16_t threshold=1, uint8_t decimals=0):
+    MenuItem(aname), variable32(NULL), variable16(variable), getter(NULL), getterArgument(NULL), shown(0), lastSample(0),
+    refreshMillis(refreshMillis), threshold(threshold), decimals(decimals), sampled(false) {};
+
+    /**
+     * @brief Watch item reading its value through a function, e.g. a sensor driver.
+     * @param getter function returning the current value
+     * @param argument optional void pointer argument passed to the getter
+     */
+    WatchMenuItem(char* aname, int32_t (*getter)(void*), void* argument=NULL, uint16_t refreshMillis=250, uint16_t threshold=1, uint8_t decimals=0):
+    MenuItem(aname), variable32(NULL), variable16(NULL), getter(getter), getterArgument(argument), shown(0), lastSample(0),
+    refreshMillis(refreshMillis), threshold(threshold), decimals(decimals), sampled(false) {};
+
+    virtual void printText(Print& out);
+
+    /**
+     * @brief Samples the source if the refresh interval has passed, and marks the item as changed if the shown value moves.
+     * @param now current millis()
+     * @return true if the text of the item changed
+     */
+    virtual bool refresh(uint32_t now);
+
+    /**
+     * @brief Watch items cannot be activated.
+     */
+    virtual bool update(menu_event_t event) {return false;};
+
+    int32_t getShownValue() {return shown;};
+    void setRefresh(uint16_t millis) {refreshMillis = millis;};
+    void setThreshold(uint16_t minimumChange) {threshold = minimumChange;};
+};
+
+/**
+ * @class MenuWatcher
+ * @file MenuWatch.h
+ * @brief Central refresh of live items. Call poll() once per loop, after navigateMenu and before updateDisplay: at most every
+ *        MENU_WATCH_INTERVAL ms it refreshes the visible items of the menu and requests one redraw if any of them changed.
+ *        Unchanged rows are skipped by the display, so ten live rows cost one frame with only the changed rows in it.
+ */
+class MenuWatcher {
+private:
+    uint32_t lastPoll;
+    uint16_t interval;
+    uint16_t redraws;
+public:
+    MenuWatcher(uint16_t interval=MENU_WATCH_INTERVAL): lastPoll(0), interval(interval), redraws(0) {};
+
+    /**
+     * @brief Refreshes the visible items of the menu if the interval has passed.
+     * @param currentMenu The menu that is shown (usually mainMenu.getCurrentSubmenu())
+     * @return true if a redraw was requested
+     */
+    bool poll(Menu* currentMenu);
+
+    void setInterval(uint16_t millis) {interval = millis;};
+
+    /**
+     * @brief Number of redraws requested because live items changed.
+     */
+    uint16_t getRedraws() {return redraws;};
+};
+
+#endif
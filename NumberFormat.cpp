@@ -0,0 +1,123 @@
+#include "NumberFormat.h"
+
+static const char digitPairs[] PROGMEM =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char hexDigits[] PROGMEM = "0123456789ABCDEF";
+
+static const uint32_t powersOf10[10] PROGMEM = {1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL};
+
+// writes the decimal digits of value so that they end just before end, returns the first digit
+static char* writeDecimal(char* end, uint32_t value) {
+    while (value>=100) {
+        uint8_t pair = value % 100;
+        value /= 100;
+        end -= 2;
+        end[0] = pgm_read_byte(&digitPairs[2*pair]);
+        end[1] = pgm_read_byte(&digitPairs[2*pair+1]);
+    }
+    if (value>=10) {
+        end -= 2;
+        end[0] = pgm_read_byte(&digitPairs[2*value]);
+        end[1] = pgm_read_byte(&digitPairs[2*value+1]);
+    } else {
+        *--end = '0'+value;
+    }
+    return end;
+}
+
+static char* writeDigits(char* end, uint32_t value, uint8_t base) {
+    if (base==10) return writeDecimal(end, value);
+    if (base==16) {
+        do {
+            *--end = pgm_read_byte(&hexDigits[value & 0x0F]);
+            value >>= 4;
+        } while (value>0);
+        return end;
+    }
+    do {
+        *--end = pgm_read_byte(&hexDigits[value % base]);
+        value /= base;
+    } while (value>0);
+    return end;
+}
+
+// copies sign, padding and digits into the destination buffer
+static uint8_t finishField(char* buffer, const char* digits, uint8_t count, bool negative, uint8_t width, char padding) {
+    uint8_t length = count + (negative ? 1 : 0);
+    if (length>NUMBER_FORMAT_LENGTH) {
+        // only binary numbers get this long: keep the low digits
+        digits += length-NUMBER_FORMAT_LENGTH;
+        count -= length-NUMBER_FORMAT_LENGTH;
+        length = NUMBER_FORMAT_LENGTH;
+    }
+    if (width>NUMBER_FORMAT_LENGTH) width = NUMBER_FORMAT_LENGTH;
+    char* out = buffer;
+    if (negative && (padding=='0')) *out++ = '-';
+    for (uint8_t i=length; i<width; i++) *out++ = padding;
+    if (negative && (padding!='0')) *out++ = '-';
+    memcpy(out, digits, count);
+    out += count;
+    *out = 0;
+    return out-buffer;
+}
+
+static uint8_t fixedField(char* buffer, uint32_t magnitude, bool negative, uint8_t decimals, uint8_t width, char padding) {
+    if (decimals>9) decimals = 9;
+    char scratch[12]; // 10 digits, decimal point and a leading zero
+    char* end = scratch+sizeof(scratch);
+    char* first = end;
+    if (decimals>0) {
+        uint32_t scale = pgm_read_dword(&powersOf10[decimals]);
+        first = writeDecimal(end, magnitude % scale);
+        magnitude /= scale;
+        while (end-first<decimals) *--first = '0';
+        *--first = '.';
+    }
+    first = writeDecimal(first, magnitude);
+    return finishField(buffer, first, end-first, negative, width, padding);
+}
+
+uint8_t formatNumber(char* buffer, int32_t value, uint8_t width, char padding) {
+    char scratch[10];
+    char* end = scratch+sizeof(scratch);
+    uint32_t magnitude = value<0 ? -(uint32_t)value : value;
+    char* first = writeDecimal(end, magnitude);
+    return finishField(buffer, first, end-first, value<0, width, padding);
+}
+
+uint8_t formatUnsigned(char* buffer, uint32_t value, uint8_t base, uint8_t width, char padding) {
+    if ((base<2) || (base>16)) base = 10;
+    char scratch[32];
+    char* end = scratch+sizeof(scratch);
+    char* first = writeDigits(end, value, base);
+    return finishField(buffer, first, end-first, false, width, padding);
+}
+
+uint8_t formatHex(char* buffer, uint32_t value, uint8_t width, char padding) {
+    return formatUnsigned(buffer, value, 16, width, padding);
+}
+
+uint8_t formatFixed(char* buffer, int32_t value, uint8_t decimals, uint8_t width, char padding) {
+    uint32_t magnitude = value<0 ? -(uint32_t)value : value;
+    return fixedField(buffer, magnitude, value<0, decimals, width, padding);
+}
+
+uint8_t formatFloat(char* buffer, float value, uint8_t decimals, uint8_t width, char padding) {
+    if (decimals>9) decimals = 9;
+    bool negative = value<0;
+    if (negative) value = -value;
+    float scaled = value*(float)pgm_read_dword(&powersOf10[decimals]) + 0.5f;
+    // the comparison is false for NaN, which is clamped as well
+    uint32_t magnitude = (scaled<4294967040.0f) ? (uint32_t)scaled : 0xFFFFFFFFUL;
+    return fixedField(buffer, magnitude, negative && (magnitude>0), decimals, width, padding);
+}
@@ -0,0 +1,54 @@
+#ifndef NUMBER_FORMAT_H
+#define NUMBER_FORMAT_H
+#include <Arduino.h>
+
+// longest field the formatting functions produce (without terminating zero); wider fields are capped
+#ifndef NUMBER_FORMAT_LENGTH
+#define NUMBER_FORMAT_LENGTH 20
+#endif
+
+// size of a buffer that holds any formatted field
+#define NUMBER_FORMAT_BUFFER_SIZE (NUMBER_FORMAT_LENGTH+1)
+
+/*
+ * Integer-only number formatting into a caller-provided buffer (at least NUMBER_FORMAT_BUFFER_SIZE bytes).
+ * Decimal digits are produced two at a time from a 200-byte digit-pair table in flash, so a value costs
+ * half as many divisions as with itoa, and the finished field can be sent to the display with a single print.
+ * All functions zero-terminate the buffer and return the number of characters written.
+ * Padding is applied left of the number; with '0' padding, the minus sign goes in front of the zeros.
+ */
+
+/**
+ * @brief Formats a signed decimal number.
+ * @param buffer destination
+ * @param value number to format
+ * @param width minimum field width (0: no padding)
+ * @param padding character used to fill the field
+ */
+uint8_t formatNumber(char* buffer, int32_t value, uint8_t width=0, char padding=' ');
+
+/**
+ * @brief Formats an unsigned number in any base from 2 to 16 (digits above 9 in upper case).
+ */
+uint8_t formatUnsigned(char* buffer, uint32_t value, uint8_t base=10, uint8_t width=0, char padding=' ');
+
+/**
+ * @brief Formats a number in hexadecimal, zero-padded by default (e.g. width 4: "00FF").
+ */
+uint8_t formatHex(char* buffer, uint32_t value, uint8_t width=0, char padding='0');
+
+/**
+ * @brief Formats a fixed-point number, e.g. value 1234 with 2 decimals: "12.34".
+ * @param value the number multiplied by 10^decimals
+ * @param decimals number of digits after the decimal point (0..9)
+ * @param width minimum field width, including sign and decimal point
+ */
+uint8_t formatFixed(char* buffer, int32_t value, uint8_t decimals, uint8_t width=0, char padding=' ');
+
+/**
+ * @brief Formats a float with a fixed number of decimals, rounded. The float is converted to fixed point once
+ *        (one multiplication), everything else is integer arithmetic. Magnitudes beyond 2^32/10^decimals are clamped.
+ */
+uint8_t formatFloat(char* buffer, float value, uint8_t decimals, uint8_t width=0, char padding=' ');
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef PARAMETER_EEPROM_H
+#define PARAMETER_EEPROM_H
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "ParameterStore.h"
+
+/**
+ * @class EEPROMStorage
+ * @file ParameterEEPROM.h
+ * @brief ParameterStorage on the Arduino EEPROM library. On ESP8266/ESP32, call EEPROM.begin(size) first; records
+ *        are committed to flash after each save.
+ */
+class EEPROMStorage: public ParameterStorage {
+public:
+    virtual uint16_t length() {return EEPROM.length();};
+    virtual uint8_t read(uint16_t address) {return EEPROM.read(address);};
+    virtual void write(uint16_t address, uint8_t value) {EEPROM.write(address, value);};
+#if defined(ESP8266) || defined(ESP32)
+    virtual void commit() {EEPROM.commit();};
+#endif
+};
+
+#endif
@@ -0,0 +1,186 @@
+#include "ParameterStore.h"
+
+// CRC-16/CCITT, bitwise (no table in flash)
+static uint16_t crcUpdate(uint16_t crc, uint8_t data) {
+    crc ^= (uint16_t)data << 8;
+    for (uint8_t bit=0; bit<8; bit++) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+    return crc;
+}
+
+bool ParameterStore::add(Parameter* parameter) {
+    if (count>=PARAMETER_STORE_MAX) return false;
+    parameters[count++] = parameter;
+    updateLayout();
+    return true;
+}
+
+void ParameterStore::updateLayout() {
+    recordSize = 4; // sequence and CRC
+    for (uint8_t i=0; i<count; i++) recordSize += parameters[i]->getStorageSize();
+    uint16_t length = areaLength;
+    if (length==0) length = (storage->length()>start) ? storage->length()-start : 0;
+    uint16_t fit = length/recordSize;
+    slots = (fit>255) ? 255 : fit;
+    slot = 0xFF;
+}
+
+uint16_t ParameterStore::crcStart() {
+    // records of another layout or size do not match
+    uint16_t crc = crcUpdate(0xFFFF, layout);
+    crc = crcUpdate(crc, recordSize & 0xFF);
+    return crcUpdate(crc, recordSize >> 8);
+}
+
+uint16_t ParameterStore::valuesCrc() {
+    uint16_t crc = crcStart();
+    uint8_t data[PARAMETER_STORAGE_SIZE];
+    for (uint8_t i=0; i<count; i++) {
+        uint8_t size = parameters[i]->getStorageSize();
+        parameters[i]->save(data);
+        for (uint8_t b=0; b<size; b++) crc = crcUpdate(crc, data[b]);
+    }
+    return crc;
+}
+
+bool ParameterStore::checkSlot(uint8_t index, uint16_t& recordSequence, uint16_t& crc) {
+    uint16_t address = start + index*recordSize;
+    uint16_t valuesEnd = address + recordSize-4;
+    crc = crcStart();
+    for (; address<valuesEnd; address++) crc = crcUpdate(crc, storage->read(address));
+    uint8_t low = storage->read(address++);
+    uint8_t high = storage->read(address++);
+    recordSequence = low | ((uint16_t)high << 8);
+    uint16_t recordCrc = crcUpdate(crcUpdate(crc, low), high);
+    uint16_t stored = storage->read(address) | ((uint16_t)storage->read(address+1) << 8);
+    return stored==recordCrc;
+}
+
+uint16_t ParameterStore::sumVersions() {
+    uint16_t sum = 0;
+    for (uint8_t i=0; i<count; i++) sum += parameters[i]->getVersion();
+    return sum;
+}
+
+uint16_t ParameterStore::readSequence(uint8_t index) {
+    uint16_t address = start + (index+1)*recordSize - 4;
+    return storage->read(address) | ((uint16_t)storage->read(address+1) << 8);
+}
+
+bool ParameterStore::findNewest() {
+    // fast path: the slot with the newest sequence number (2 bytes per slot), which is valid unless its write was cut short
+    uint8_t candidate = 0xFF;
+    uint16_t newest = 0;
+    for (uint8_t index=0; index<slots; index++) {
+        uint16_t recordSequence = readSequence(index);
+        // newest by sequence number, in wrapping arithmetic
+        if ((candidate==0xFF) || ((int16_t)(recordSequence-newest)>0)) {
+            candidate = index;
+            newest = recordSequence;
+        }
+    }
+    uint16_t recordSequence, crc;
+    if ((candidate!=0xFF) && checkSlot(candidate, recordSequence, crc)) {
+        slot = candidate;
+        sequence = recordSequence;
+        savedCrc = crc;
+        return true;
+    }
+    // cut short or never written: check every slot
+    for (uint8_t index=0; index<slots; index++) {
+        if (!checkSlot(index, recordSequence, crc)) continue;
+        if ((slot==0xFF) || ((int16_t)(recordSequence-sequence)>0)) {
+            slot = index;
+            sequence = recordSequence;
+            savedCrc = crc;
+        }
+    }
+    return slot!=0xFF;
+}
+
+bool ParameterStore::restore() {
+    slot = 0xFF;
+    if (!findNewest()) return false;
+    uint16_t address = start + slot*recordSize;
+    uint8_t data[PARAMETER_STORAGE_SIZE];
+    for (uint8_t i=0; i<count; i++) {
+        uint8_t size = parameters[i]->getStorageSize();
+        for (uint8_t b=0; b<size; b++) data[b] = storage->read(address++);
+        if (size==0) continue;
+        uint8_t version = parameters[i]->getVersion();
+        parameters[i]->load(data);
+        // parameters only report changes: restored values equal to the current ones still get their callback
+        if (parameters[i]->getVersion()==version) parameters[i]->notify();
+    }
+    versions = sumVersions();
+    dirty = false;
+    return true;
+}
+
+void ParameterStore::update(uint16_t address, uint8_t value) {
+    if (storage->read(address)==value) return;
+    storage->write(address, value);
+    bytesWritten++;
+}
+
+bool ParameterStore::save() {
+    dirty = false;
+    versions = sumVersions();
+    if (slots==0) return false;
+    uint16_t crc = valuesCrc();
+    if ((slot!=0xFF) && (crc==savedCrc)) return false;
+    savedCrc = crc;
+    slot = (slot==0xFF || slot+1>=slots) ? 0 : slot+1;
+    sequence++;
+    uint16_t address = start + slot*recordSize;
+    uint8_t data[PARAMETER_STORAGE_SIZE];
+    for (uint8_t i=0; i<count; i++) {
+        uint8_t size = parameters[i]->getStorageSize();
+        parameters[i]->save(data);
+        for (uint8_t b=0; b<size; b++) update(address++, data[b]);
+    }
+    crc = crcUpdate(crcUpdate(crc, sequence & 0xFF), sequence >> 8);
+    update(address++, sequence & 0xFF);
+    update(address++, sequence >> 8);
+    // the CRC goes last: the record only becomes valid when it is complete
+    update(address++, crc & 0xFF);
+    update(address, crc >> 8);
+    storage->commit();
+    saves++;
+    return true;
+}
+
+ParameterStore* ParameterStore::committing = NULL;
+
+void ParameterStore::commitHandler(Parameter* parameter) {
+    ParameterStore* store = committing;
+    for (uint8_t i=0; i<store->count; i++) {
+        if (store->parameters[i]==parameter) {
+            store->save();
+            return;
+        }
+    }
+}
+
+void ParameterStore::saveOnCommit(bool enable) {
+    if (enable) {
+        committing = this;
+        Parameter::setCommitHandler(commitHandler);
+    } else if (committing==this) {
+        committing = NULL;
+        Parameter::setCommitHandler(NULL);
+    }
+}
+
+bool ParameterStore::run() {
+    uint16_t sum = sumVersions();
+    uint32_t now = millis();
+    if (sum!=versions) {
+        versions = sum;
+        dirty = true;
+        lastChange = now;
+    }
+    if (!dirty || (now-lastChange<saveDelay)) return false;
+    return save();
+}
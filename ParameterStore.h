@@ -0,0 +1,140 @@
+#ifndef PARAMETER_STORE_H
+#define PARAMETER_STORE_H
+#include <Arduino.h>
+#include "parameters.h"
+
+// maximum number of parameters in a ParameterStore
+#ifndef PARAMETER_STORE_MAX
+#define PARAMETER_STORE_MAX 16
+#endif
+
+// default time in milliseconds without changes before a ParameterStore saves
+#ifndef PARAMETER_STORE_DELAY
+#define PARAMETER_STORE_DELAY 2000
+#endif
+
+/**
+ * @class ParameterStorage
+ * @file ParameterStore.h
+ * @brief Interface to non-volatile memory for ParameterStore, byte by byte. See EEPROMStorage (ParameterEEPROM.h)
+ *        for the Arduino EEPROM library.
+ */
+class ParameterStorage {
+public:
+    /**
+     * @brief Size of the memory in bytes.
+     */
+    virtual uint16_t length() = 0;
+    virtual uint8_t read(uint16_t address) = 0;
+    /**
+     * @brief Writes one byte. ParameterStore only writes bytes that differ from what read() returns.
+     */
+    virtual void write(uint16_t address, uint8_t value) = 0;
+    /**
+     * @brief Called after a record has been written, for memories that buffer writes (e.g. EEPROM emulated in flash).
+     */
+    virtual void commit() {};
+};
+
+/**
+ * @class ParameterStore
+ * @file ParameterStore.h
+ * @brief Keeps the values of registered parameters in non-volatile memory. The values are saved as one record:
+ *          value bytes of all parameters (Parameter::save), 16 bit sequence number, CRC-16 over both
+ *        The memory area is split into as many record slots as fit, and each save goes to the slot after the newest one,
+ *        so the wear is spread over the whole area. Of the new record only the bytes that differ from what the slot held
+ *        before are written, and nothing is written if the values equal the newest record. A record that was cut short
+ *        (power loss while saving) fails its CRC, and restore() falls back to the previous one.
+ *
+ *        Call run() from the main loop: it saves once the parameters stopped changing for PARAMETER_STORE_DELAY ms, so
+ *        sweeping a value writes one record at the end. With saveOnCommit(), the values are saved as soon as the editing of
+ *        a registered parameter ends (Parameter::commit, called by ParamMenuItem); save() writes right away at any time.
+ *        restore() reads only the sequence numbers of the slots and then the newest record; all slots are checked only
+ *        if that record is damaged.
+ *        Register all parameters before restore(); the layout version (and the record size) tell records of different
+ *        parameter lists apart, so a changed list starts from the defaults.
+ */
+class ParameterStore {
+private:
+    ParameterStorage* storage;
+    Parameter* parameters[PARAMETER_STORE_MAX];
+    uint8_t count;
+    uint8_t layout;
+    uint16_t start;
+    uint16_t areaLength;
+    uint16_t recordSize;
+    uint8_t slots;
+    uint8_t slot;             // slot of the newest record (0xFF: none)
+    uint16_t sequence;        // sequence number of the newest record
+    uint16_t savedCrc;        // CRC of the values in the newest record
+    uint16_t versions;        // sum of the parameter versions at the last check
+    bool dirty;
+    uint32_t lastChange;
+    uint16_t saveDelay;
+    uint16_t saves;
+    uint32_t bytesWritten;
+
+    void updateLayout();
+    uint16_t crcStart();
+    uint16_t valuesCrc();
+    bool checkSlot(uint8_t index, uint16_t& recordSequence, uint16_t& crc);
+    uint16_t readSequence(uint8_t index);
+    bool findNewest();
+    static ParameterStore* committing; // store saving on commit
+    static void commitHandler(Parameter* parameter);
+    uint16_t sumVersions();
+    void update(uint16_t address, uint8_t value);
+public:
+    /**
+     * @brief Constructor for a parameter store.
+     * @param storage the memory
+     * @param start first address of the area used
+     * @param length size of the area (0: up to the end of the memory). Records are spread over the whole area.
+     * @param layout version of the parameter list: change it when parameters change their meaning
+     */
+    ParameterStore(ParameterStorage* storage, uint16_t start=0, uint16_t length=0, uint8_t layout=0):
+    storage(storage), count(0), layout(layout), start(start), areaLength(length), recordSize(0), slots(0), slot(0xFF),
+    sequence(0), savedCrc(0), versions(0), dirty(false), lastChange(0), saveDelay(PARAMETER_STORE_DELAY), saves(0), bytesWritten(0) {};
+
+    /**
+     * @brief Registers a parameter.
+     * @return false if PARAMETER_STORE_MAX parameters are registered already
+     */
+    bool add(Parameter* parameter);
+
+    /**
+     * @brief Sets all parameters to the values of the newest valid record (their callbacks are called). Call once at boot,
+     *        after registering the parameters.
+     * @return false if no valid record was found (the parameters keep their values)
+     */
+    bool restore();
+
+    /**
+     * @brief Saves the values into the next slot, unless they equal the newest record.
+     * @return true if a record was written
+     */
+    bool save();
+
+    /**
+     * @brief Call regularly from the main loop: saves when parameters changed, and then did not change for the delay.
+     * @return true if a record was written
+     */
+    bool run();
+
+    /**
+     * @brief Saves when the editing of a registered parameter is committed (MENU_SELECT or MENU_LEAVE in a ParamMenuItem).
+     *        One store at a time can save on commit.
+     * @param enable false to stop saving on commit
+     */
+    void saveOnCommit(bool enable=true);
+
+    void setDelay(uint16_t millis) {saveDelay = millis;};
+    bool isDirty() {return dirty;};
+
+    uint8_t getSlots() {return slots;};
+    uint16_t getRecordSize() {return recordSize;};
+    uint16_t getSaves() {return saves;};             // records written
+    uint32_t getBytesWritten() {return bytesWritten;}; // bytes that differed and were written
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "RotaryEncoder.h"
+#include "MenuStats.h"
+
+// direction of a transition, indexed by previous state << 2 | new state: +1 for the order 0, 2, 3, 1 (channel A
+// leads), -1 for the reverse, 0 for no change and for invalid transitions where both channels changed
+static const int8_t quadratureTable[16] PROGMEM = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+// attachInterrupt handlers carry no argument
+static RotaryEncoder* attachedEncoder = NULL;
+
+static void encoderInterrupt() {
+    if (attachedEncoder!=NULL) attachedEncoder->handleInterrupt();
+}
+
+RotaryEncoder::RotaryEncoder(uint8_t pinA, uint8_t pinB, uint8_t config):
+pinA(pinA), pinB(pinB), statesPerDetent(ROTARY_ENCODER_STATES_PER_DETENT), state(0), quarter(0), steps(0), detents(0),
+position(0), lastDetent(0) {
+    pinMode(pinA, config);
+    pinMode(pinB, config);
+    setAcceleration(ROTARY_ENCODER_ACCEL_TIME, ROTARY_ENCODER_ACCEL_MAX);
+}
+
+void RotaryEncoder::begin() {
+    state = readState();
+    quarter = 0;
+    int8_t interruptA = digitalPinToInterrupt(pinA);
+    int8_t interruptB = digitalPinToInterrupt(pinB);
+    if ((interruptA==NOT_AN_INTERRUPT) || (interruptB==NOT_AN_INTERRUPT)) return;
+    attachedEncoder = this;
+    attachInterrupt(interruptA, encoderInterrupt, CHANGE);
+    attachInterrupt(interruptB, encoderInterrupt, CHANGE);
+}
+
+void RotaryEncoder::end() {
+    if (attachedEncoder!=this) return;
+    detachInterrupt(digitalPinToInterrupt(pinA));
+    detachInterrupt(digitalPinToInterrupt(pinB));
+    attachedEncoder = NULL;
+}
+
+void RotaryEncoder::setAcceleration(uint8_t time, uint8_t maxFactor) {
+    accelTime = time;
+    // rounded here and in handleInterrupt, so that the fastest detents reach maxFactor (truncating twice lost one step)
+    accelGain = ((time>0) && (maxFactor>1)) ? (((uint16_t)(maxFactor-1) << 8) + time/2) / time : 0;
+}
+
+void RotaryEncoder::handleInterrupt() {
+    uint8_t newState = readState();
+    int8_t direction = (int8_t)pgm_read_byte(&quadratureTable[(state << 2) | newState]);
+    state = newState;
+    if (direction==0) return;
+    quarter += direction;
+    if ((quarter>-(int8_t)statesPerDetent) && (quarter<(int8_t)statesPerDetent)) return;
+    // a detent is completed
+    quarter = 0;
+    uint32_t now = millis();
+    uint32_t interval = now-lastDetent;
+    lastDetent = now;
+    int16_t count = 1;
+    if (interval<accelTime) count += ((accelTime-interval)*accelGain + 128) >> 8;
+    if (direction>0) {
+        steps += count;
+        detents++;
+        position++;
+    } else {
+        steps -= count;
+        detents--;
+        position--;
+    }
+}
+
+int16_t RotaryEncoder::read(bool accelerate) {
+    MENU_STATS_STAGE(STAGE_INPUT);
+    noInterrupts();
+    int16_t result = accelerate ? steps : detents;
+    steps = 0;
+    detents = 0;
+    interrupts();
+    if (result!=0) MENU_STATS_INPUT();
+    return result;
+}
+
+int32_t RotaryEncoder::getPosition() {
+    noInterrupts();
+    int32_t result = position;
+    interrupts();
+    return result;
+}
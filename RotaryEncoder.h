@@ -0,0 +1,102 @@
+#ifndef ROTARY_ENCODER_H
+#define ROTARY_ENCODER_H
+#include <Arduino.h>
+
+// quadrature states (edges of both channels) per detent of typical mechanical encoders
+#ifndef ROTARY_ENCODER_STATES_PER_DETENT
+#define ROTARY_ENCODER_STATES_PER_DETENT 4
+#endif
+
+// detents closer than this (in milliseconds) are accelerated, the closer the more
+#ifndef ROTARY_ENCODER_ACCEL_TIME
+#define ROTARY_ENCODER_ACCEL_TIME 40
+#endif
+
+// steps per detent at the highest speed (1: no acceleration)
+#ifndef ROTARY_ENCODER_ACCEL_MAX
+#define ROTARY_ENCODER_ACCEL_MAX 8
+#endif
+
+/**
+ * @class RotaryEncoder
+ * @file RotaryEncoder.h
+ * @brief Interrupt-driven quadrature encoder. Every edge of either channel is decoded from a state table, which
+ *        ignores contact bounce (a bouncing channel moves back and forth between two states) and invalid transitions.
+ *        Completed detents are accumulated as signed steps, and detents that follow each other quickly count as several
+ *        steps (acceleration), so a wide range can be crossed with a short turn while slow turns keep single steps.
+ *
+ *        The main loop collects the steps of all detents since the last call with read() and hands them to
+ *        Menu::navigateBy() as one cursor move or one parameter change. Positive steps turn the same way as MENU_UP.
+ *
+ *        Only one instance can be attached to interrupts. begin() uses attachInterrupt() if both pins have an external
+ *        interrupt (digitalPinToInterrupt). Otherwise call handleInterrupt() from your own pin change ISR, or from the main
+ *        loop at least once per quadrature state.
+ */
+class RotaryEncoder {
+private:
+    uint8_t pinA;
+    uint8_t pinB;
+    uint8_t statesPerDetent;
+    uint8_t accelTime;        // detent interval below which steps are multiplied
+    uint16_t accelGain;       // extra steps per ms below accelTime, in 1/256
+    volatile uint8_t state;   // last levels of A and B (bits 1 and 0)
+    volatile int8_t quarter;  // states moved within the current detent
+    volatile int16_t steps;   // accelerated steps not read yet
+    volatile int16_t detents; // detents not read yet
+    volatile int32_t position;// detents since begin
+    uint32_t lastDetent;      // millis() of the last detent
+
+    uint8_t readState() {return (digitalRead(pinA)==LOW ? 2 : 0) | (digitalRead(pinB)==LOW ? 1 : 0);};
+public:
+    /**
+     * @brief Constructor for a rotary encoder.
+     * @param pinA Input pin of channel A
+     * @param pinB Input pin of channel B
+     * @param config Pin state flag (pull-up, pull-down, etc.) for pin configuration.
+     */
+    RotaryEncoder(uint8_t pinA, uint8_t pinB, uint8_t config=INPUT_PULLUP);
+
+    /**
+     * @brief Reads the initial state and attaches the interrupt handlers.
+     */
+    void begin();
+
+    /**
+     * @brief Detaches the interrupt handlers.
+     */
+    void end();
+
+    /**
+     * @brief Decodes the current pin levels. Called from the interrupt handler; call it from your own pin change ISR
+     *        for pins without an external interrupt.
+     */
+    void handleInterrupt();
+
+    /**
+     * @brief Returns the steps turned since the last call and clears them.
+     * @param accelerate true for accelerated steps (e.g. to change a value), false for one step per detent (e.g. to move
+     *        through a list)
+     * @return signed number of steps, positive in the direction of MENU_UP
+     */
+    int16_t read(bool accelerate=true);
+
+    /**
+     * @brief Absolute position in detents since begin(), without acceleration.
+     */
+    int32_t getPosition();
+
+    /**
+     * @brief Sets the acceleration curve: a detent following the previous one after t < time ms counts as
+     *        1 + (maxFactor-1)*(time-t)/time steps, rounded (maxFactor for detents in the same millisecond).
+     * @param time interval in milliseconds below which detents are accelerated (0: no acceleration)
+     * @param maxFactor steps per detent at the highest speed
+     */
+    void setAcceleration(uint8_t time, uint8_t maxFactor);
+
+    /**
+     * @brief Sets the number of quadrature states per detent (4 for most encoders, 2 or 1 for others).
+     */
+    void setStatesPerDetent(uint8_t states) {statesPerDetent = (states>0) ? states : 1;};
+};
+
+#endif
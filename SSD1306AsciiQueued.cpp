@@ -0,0 +1,81 @@
+#include "SSD1306AsciiQueued.h"
+
+#define DISPLAY_QUEUE_MASK (DISPLAY_QUEUE_PACKETS-1)
+
+void WireTransport::transmit(uint8_t address, const uint8_t* data, uint8_t length) {
+    Wire.beginTransmission(address);
+    Wire.write(data, length);
+    Wire.endTransmission();
+    owner->transmitComplete();
+}
+
+void SSD1306AsciiQueued::begin(const DevType* dev, uint8_t i2cAddr, DisplayTransport* transport) {
+    address = i2cAddr;
+    this->transport = transport;
+    transport->setOwner(this);
+    init(dev);
+}
+
+void SSD1306AsciiQueued::writeDisplay(uint8_t b, uint8_t mode) {
+    uint8_t control = mode==SSD1306_MODE_CMD ? 0x00 : 0x40;
+    if (open && ((packets[tail].data[0]!=control) || (packets[tail].length>=DISPLAY_QUEUE_PACKET_SIZE))) closePacket();
+    if (!open) {
+        // one packet always stays free, so that the packet being filled can be closed
+        if (((tail+1) & DISPLAY_QUEUE_MASK)==head) {
+            stallCount++;
+            while (((tail+1) & DISPLAY_QUEUE_MASK)==head) transport->wait();
+        }
+        packets[tail].data[0] = control;
+        packets[tail].length = 1;
+        open = true;
+        byteCount++;
+    }
+    Packet& packet = packets[tail];
+    packet.data[packet.length++] = b;
+    byteCount++;
+    // a page address completes a cursor move; send it rather than waiting for more commands
+    if ((mode==SSD1306_MODE_CMD) && ((b & 0xF8)==SSD1306_SETSTARTPAGE)) closePacket();
+}
+
+void SSD1306AsciiQueued::closePacket() {
+    if (!open) return;
+    open = false;
+    packetCount++;
+    EVENT_QUEUE_BARRIER();
+    tail = (tail+1) & DISPLAY_QUEUE_MASK;
+    // start the transport unless it is already working through the queue
+    noInterrupts();
+    bool start = !busy;
+    busy = true;
+    interrupts();
+    if (start) startNext();
+}
+
+void SSD1306AsciiQueued::startNext() {
+    // a blocking transport completes inside transmit(); loop here instead of recursing through transmitComplete()
+    do {
+        completedInline = false;
+        inTransmit = true;
+        transport->transmit(address, packets[head].data, packets[head].length);
+        inTransmit = false;
+    } while (completedInline && busy);
+}
+
+void SSD1306AsciiQueued::transmitComplete() {
+    head = (head+1) & DISPLAY_QUEUE_MASK;
+    if (head==tail) busy = false;
+    if (inTransmit) {
+        completedInline = true;
+        return;
+    }
+    if (busy) startNext();
+}
+
+void SSD1306AsciiQueued::flush() {
+    closePacket();
+}
+
+void SSD1306AsciiQueued::waitIdle() {
+    flush();
+    while (!isIdle()) transport->wait();
+}
@@ -0,0 +1,140 @@
+#ifndef SSD1306_ASCII_QUEUED_H
+#define SSD1306_ASCII_QUEUED_H
+#include <Arduino.h>
+#include <Wire.h>
+#include "SSD1306Ascii.h"
+#include "SSD1306AsciiWire.h"
+#include "EventQueue.h"
+
+// number of transmit packets in the ring (power of two). A packet is one I2C transaction.
+#ifndef DISPLAY_QUEUE_PACKETS
+#if defined(__AVR__)
+#define DISPLAY_QUEUE_PACKETS 8
+#else
+#define DISPLAY_QUEUE_PACKETS 64
+#endif
+#endif
+
+// bytes per packet including the control byte (the AVR Wire buffer holds 32)
+#ifndef DISPLAY_QUEUE_PACKET_SIZE
+#define DISPLAY_QUEUE_PACKET_SIZE 32
+#endif
+
+class SSD1306AsciiQueued;
+
+/**
+ * @class DisplayTransport
+ * @file SSD1306AsciiQueued.h
+ * @brief Interface to the I2C hardware for SSD1306AsciiQueued. An implementation starts a transaction and returns right away;
+ *        when the transaction has completed (in the I2C interrupt or the DMA completion handler), it calls
+ *        SSD1306AsciiQueued::transmitComplete(), which starts the next queued packet from there.
+ */
+class DisplayTransport {
+public:
+    /**
+     * @brief Starts sending one packet (address, then length bytes).
+     */
+    virtual void transmit(uint8_t address, const uint8_t* data, uint8_t length) = 0;
+
+    /**
+     * @brief Called while the transmit ring is full. Returns when the transport has made progress (the default just returns,
+     *        which is right for interrupt-driven transports; the ring is polled again).
+     */
+    virtual void wait() {};
+
+    /**
+     * @brief Sets the display that is notified about completed packets.
+     */
+    void setOwner(SSD1306AsciiQueued* display) {owner = display;};
+protected:
+    SSD1306AsciiQueued* owner;
+};
+
+/**
+ * @class WireTransport
+ * @file SSD1306AsciiQueued.h
+ * @brief Blocking fallback transport using the Wire library. Packets are still packed (several commands or 31 data
+ *        bytes per transaction), but transmit() only returns when the transaction is done.
+ */
+class WireTransport: public DisplayTransport {
+public:
+    virtual void transmit(uint8_t address, const uint8_t* data, uint8_t length);
+};
+
+/**
+ * @class SSD1306AsciiQueued
+ * @file SSD1306AsciiQueued.h
+ * @brief SSD1306 text display whose output is queued instead of sent with blocking Wire transactions. Commands and display
+ *        data are packed into packets in a ring of transmit buffers, and a DisplayTransport drains the ring in the background
+ *        (I2C interrupt or DMA), so that drawing a frame only costs the time to fill the buffers. If the ring is full, writing
+ *        waits for the transport. Can be used wherever an SSD1306AsciiWire is expected, e.g. by MenuDisplay.
+ *
+ *        Consecutive commands share one packet (control byte 0x00), data bytes fill packets up to DISPLAY_QUEUE_PACKET_SIZE.
+ *        A packet is handed to the transport when it is full, when the data type changes or after a page address command,
+ *        so all drawing is sent without explicit flushing; call flush() to also send a trailing column address.
+ */
+class SSD1306AsciiQueued: public SSD1306AsciiWire {
+private:
+    struct Packet {
+        uint8_t length;
+        uint8_t data[DISPLAY_QUEUE_PACKET_SIZE];
+    };
+    Packet packets[DISPLAY_QUEUE_PACKETS];
+    volatile uint8_t head;  // next packet to send (consumer: transport)
+    volatile uint8_t tail;  // packet being filled (producer: drawing code)
+    volatile bool busy;     // transport is sending the head packet
+    volatile bool inTransmit;
+    volatile bool completedInline;
+    bool open;              // the tail packet has content
+    uint8_t address;
+    DisplayTransport* transport;
+    uint32_t packetCount;
+    uint32_t byteCount;
+    uint32_t stallCount;
+
+    void closePacket();
+    void startNext();
+    static_assert((DISPLAY_QUEUE_PACKETS & (DISPLAY_QUEUE_PACKETS-1))==0, "DISPLAY_QUEUE_PACKETS must be a power of two");
+protected:
+    virtual void writeDisplay(uint8_t b, uint8_t mode);
+public:
+    SSD1306AsciiQueued():
+    head(0), tail(0), busy(false), inTransmit(false), completedInline(false), open(false), address(0x3C), transport(NULL),
+    packetCount(0), byteCount(0), stallCount(0) {};
+
+    /**
+     * @brief Initialises the display through the transport.
+     * @param dev display type, e.g. &Adafruit128x64
+     * @param i2cAddr I2C address of the display
+     * @param transport the I2C transport draining the queue
+     */
+    void begin(const DevType* dev, uint8_t i2cAddr, DisplayTransport* transport);
+
+    /**
+     * @brief Hands a partly filled packet to the transport.
+     */
+    void flush();
+
+    /**
+     * @brief True when all queued packets have been sent. Everything drawn is on the display then; only a trailing
+     *        cursor command may still be held back in the open packet until flush() or the next write.
+     */
+    bool isIdle() {return !busy && (head==tail);};
+
+    /**
+     * @brief Flushes and waits until the queue is idle.
+     */
+    void waitIdle();
+
+    /**
+     * @brief To be called by the transport when the current packet has been sent (may be called from an interrupt).
+     */
+    void transmitComplete();
+
+    uint32_t getPackets() {return packetCount;};   // packets queued
+    uint32_t getBytes() {return byteCount;};       // bytes queued, including control bytes (without address)
+    uint32_t getStalls() {return stallCount;};     // writes that had to wait for a free packet
+    void resetCounters() {packetCount = 0; byteCount = 0; stallCount = 0;};
+};
+
+#endif
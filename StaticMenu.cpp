@@ -0,0 +1,73 @@
+#include "StaticMenu.h"
+
+bool FlashNavigationItem::update(menu_event_t event) {
+    // back items are handled by the root menu (leavesMenu), which asks the flash menu to leave a level first
+    owner->enterLevel(target);
+    return false;
+};
+
+MenuItem* FlashMenu::getItem(uint16_t index) {
+    if (index>=maxCount) return NULL;
+    const StaticMenuItemDef* def = levels[depth] + 1 + index;
+    if (def!=loaded) {
+        memcpy_P(&entry, def, sizeof(entry));
+        loaded = def;
+        switch (entry.type) {
+            case STATIC_ITEM_PARAM:
+                paramItem = ParamMenuItem(entry.name, entry.parameter, entry.knob);
+            break;
+            case STATIC_ITEM_ACTION:
+                actionItem = ActionMenuItem(entry.name, entry.callback, entry.callbackArgument);
+            break;
+            case STATIC_ITEM_SUBMENU:
+                navigationItem.set(entry.name, entry.submenu);
+            break;
+            case STATIC_ITEM_BACK:
+                navigationItem.set(entry.name, NULL);
+            break;
+            default:
+            break;
+        }
+    }
+    switch (entry.type) {
+        case STATIC_ITEM_PARAM:
+            return &paramItem;
+        case STATIC_ITEM_ACTION:
+            return &actionItem;
+        case STATIC_ITEM_SUBMENU:
+        case STATIC_ITEM_BACK:
+            return &navigationItem;
+        default:
+            return &textItem;
+    }
+}
+
+void FlashMenu::printText(Print& out) {
+    out.print((const __FlashStringHelper*)levels[0]->name);
+}
+
+void FlashMenu::setLevel(const StaticMenuItemDef* header) {
+    maxCount = pgm_read_byte(&header->count);
+    loaded = NULL;
+    itemsChanged(); // the same item objects now show other entries
+}
+
+void FlashMenu::enterLevel(const StaticMenuItemDef* submenu) {
+    if ((submenu==NULL) || (depth>=STATIC_MENU_DEPTH)) return;
+    savedSelection[depth] = selectedItem;
+    savedScroll[depth] = scrollOffset;
+    depth++;
+    levels[depth] = submenu;
+    selectedItem = 0;
+    scrollOffset = 0;
+    setLevel(submenu);
+}
+
+bool FlashMenu::leaveLevel() {
+    if (depth==0) return false;
+    depth--;
+    selectedItem = savedSelection[depth];
+    scrollOffset = savedScroll[depth];
+    setLevel(levels[depth]);
+    return true;
+}
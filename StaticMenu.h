@@ -0,0 +1,209 @@
+#ifndef STATIC_MENU_H
+#define STATIC_MENU_H
+#include <Arduino.h>
+#include "Menu.h"
+
+// maximum length of item names in static menus, including the terminating zero
+#ifndef STATIC_MENU_NAME_LENGTH
+#define STATIC_MENU_NAME_LENGTH 16
+#endif
+
+// maximum nesting depth of submenus in a FlashMenu
+#ifndef STATIC_MENU_DEPTH
+#define STATIC_MENU_DEPTH 4
+#endif
+
+typedef enum static_item_t {STATIC_MENU_HEADER, STATIC_ITEM_TEXT, STATIC_ITEM_PARAM, STATIC_ITEM_SUBMENU, STATIC_ITEM_BACK, STATIC_ITEM_ACTION} static_item_t;
+
+namespace static_menu_detail {
+    // index sequence 0..N-1 to copy a string literal into a fixed-size array at compile time
+    template <unsigned... I> struct Indices {};
+    template <unsigned N, unsigned... I> struct MakeIndices: MakeIndices<N-1, N-1, I...> {};
+    template <unsigned... I> struct MakeIndices<0, I...> {typedef Indices<I...> type;};
+    typedef MakeIndices<STATIC_MENU_NAME_LENGTH>::type NameIndices;
+
+    template <unsigned N>
+    constexpr char charAt(const char (&str)[N], unsigned i) {
+        return i<N-1 ? str[i] : '\0';
+    }
+}
+
+/**
+ * @class StaticMenuItemDef
+ * @file StaticMenu.h
+ * @brief Constant description of one entry of a static menu. The name is stored inside the entry, so a menu declared
+ *        PROGMEM keeps all of its strings in flash. Create entries with the menuText/menuParam/menuSubmenu/menuBack/menuAction
+ *        functions and combine them with makeMenu().
+ */
+struct StaticMenuItemDef {
+    char name[STATIC_MENU_NAME_LENGTH];
+    uint8_t type;
+    uint8_t count;                        // number of items (header entries only)
+    Parameter* parameter;
+    AnalogKnob* knob;
+    const StaticMenuItemDef* submenu;     // header entry of the submenu
+    bool (*callback)(void*);
+    void* callbackArgument;
+
+    StaticMenuItemDef() {};
+
+    template <unsigned N, unsigned... I>
+    constexpr StaticMenuItemDef(const char (&aname)[N], static_menu_detail::Indices<I...>, uint8_t type, uint8_t count,
+        Parameter* parameter, AnalogKnob* knob, const StaticMenuItemDef* submenu, bool (*callback)(void*), void* callbackArgument):
+        name{static_menu_detail::charAt(aname, I)...}, type(type), count(count), parameter(parameter), knob(knob),
+        submenu(submenu), callback(callback), callbackArgument(callbackArgument) {};
+};
+
+/**
+ * @class StaticMenu
+ * @file StaticMenu.h
+ * @brief A complete static menu: a header entry with the menu name and item count, followed by the items.
+ *        Declare it const and PROGMEM, e.g.
+ *        const auto valueMenu PROGMEM = makeMenu("Values", menuParam("Value", &pVal), menuBack());
+ */
+template <uint8_t N>
+struct StaticMenu {
+    StaticMenuItemDef entries[N+1];
+};
+
+template <unsigned N>
+constexpr StaticMenuItemDef staticMenuEntry(const char (&name)[N], uint8_t type, uint8_t count=0, Parameter* parameter=NULL, AnalogKnob* knob=NULL,
+    const StaticMenuItemDef* submenu=NULL, bool (*callback)(void*)=NULL, void* callbackArgument=NULL) {
+    static_assert(N<=STATIC_MENU_NAME_LENGTH, "menu item name too long (see STATIC_MENU_NAME_LENGTH)");
+    return StaticMenuItemDef(name, static_menu_detail::NameIndices(), type, count, parameter, knob, submenu, callback, callbackArgument);
+}
+
+/**
+ * @brief Plain text item without function.
+ */
+template <unsigned N>
+constexpr StaticMenuItemDef menuText(const char (&name)[N]) {
+    return staticMenuEntry(name, STATIC_ITEM_TEXT);
+}
+
+/**
+ * @brief Parameter item, behaves like ParamMenuItem.
+ */
+template <unsigned N>
+constexpr StaticMenuItemDef menuParam(const char (&name)[N], Parameter* parameter, AnalogKnob* knob=NULL) {
+    return staticMenuEntry(name, STATIC_ITEM_PARAM, 0, parameter, knob);
+}
+
+/**
+ * @brief Item entering another static menu (which has to be declared before).
+ */
+template <unsigned N, uint8_t M>
+constexpr StaticMenuItemDef menuSubmenu(const char (&name)[N], const StaticMenu<M>& submenu) {
+    return staticMenuEntry(name, STATIC_ITEM_SUBMENU, 0, NULL, NULL, submenu.entries);
+}
+
+/**
+ * @brief Item returning to the enclosing menu.
+ */
+template <unsigned N>
+constexpr StaticMenuItemDef menuBack(const char (&name)[N]) {
+    return staticMenuEntry(name, STATIC_ITEM_BACK);
+}
+
+constexpr StaticMenuItemDef menuBack() {
+    return staticMenuEntry("back...", STATIC_ITEM_BACK);
+}
+
+/**
+ * @brief Action item, behaves like ActionMenuItem.
+ */
+template <unsigned N>
+constexpr StaticMenuItemDef menuAction(const char (&name)[N], bool (*callback)(void*), void* callbackArgument=NULL) {
+    return staticMenuEntry(name, STATIC_ITEM_ACTION, 0, NULL, NULL, NULL, callback, callbackArgument);
+}
+
+/**
+ * @brief Builds a static menu from a name and a list of items. The item count is computed at compile time.
+ */
+template <unsigned N, typename... Items>
+constexpr StaticMenu<sizeof...(Items)> makeMenu(const char (&name)[N], Items... items) {
+    static_assert(sizeof...(Items)<=255, "too many items in a static menu");
+    return StaticMenu<sizeof...(Items)>{{staticMenuEntry(name, STATIC_MENU_HEADER, sizeof...(Items)), items...}};
+}
+
+class FlashMenu;
+
+/**
+ * @class FlashNavigationItem
+ * @file StaticMenu.h
+ * @brief Submenu and back items of a FlashMenu. Moves the FlashMenu to another level when selected.
+ */
+class FlashNavigationItem: public MenuItem {
+protected:
+    FlashMenu* owner;
+    const StaticMenuItemDef* target; // header of the submenu, or NULL to go back
+public:
+    FlashNavigationItem(FlashMenu* owner):
+        MenuItem(""), owner(owner), target(NULL) { };
+    void set(char* aname, const StaticMenuItemDef* submenu) {name = aname; target = submenu;};
+    virtual bool update(menu_event_t event);
+    virtual bool leavesMenu() {return target==NULL;};
+};
+
+/**
+ * @class FlashMenu
+ * @file StaticMenu.h
+ * @brief Runtime menu for a tree of static menus in flash. Only one item is materialised in RAM at a time (the one that is
+ *        displayed or updated), and submenus are entered by switching this one object to another level, keeping the parent
+ *        positions on a small stack. RAM use depends on STATIC_MENU_DEPTH, not on the size of the tree.
+ *        Use it like any other Menu, usually as the main menu.
+ */
+class FlashMenu: public Menu {
+protected:
+    const StaticMenuItemDef* levels[STATIC_MENU_DEPTH+1]; // header entries from the root to the current level
+    uint8_t savedSelection[STATIC_MENU_DEPTH];
+    uint8_t savedScroll[STATIC_MENU_DEPTH];
+    uint8_t depth;
+
+    // RAM copy of the materialised entry and the item objects presenting it
+    const StaticMenuItemDef* loaded;
+    StaticMenuItemDef entry;
+    MenuItem textItem;
+    ParamMenuItem paramItem;
+    ActionMenuItem actionItem;
+    FlashNavigationItem navigationItem;
+
+    void setLevel(const StaticMenuItemDef* header);
+public:
+    /**
+     * @brief Constructor for a flash menu.
+     * @param root Static root menu (declared PROGMEM)
+     * @param rollover activates roll-over at the top and bottom of the menu
+     * @param menuLines number of lines that fit on the display.
+     */
+    template <uint8_t N>
+    FlashMenu(const StaticMenu<N>& root, bool rollover=false, uint8_t menuLines=4):
+    Menu(NULL, N, "", rollover, menuLines), depth(0), loaded(NULL),
+    textItem(entry.name), paramItem(entry.name), actionItem(entry.name), navigationItem(this) {
+        levels[0] = root.entries;
+    };
+
+    virtual MenuItem* getItem(uint16_t index);
+
+    /**
+     * @brief Name of the root menu (read from flash), used when the flash menu is an item of another menu.
+     */
+    virtual void printText(Print& out);
+
+    /**
+     * @brief Enters a submenu of the static tree.
+     * @param submenu Header entry of the submenu
+     */
+    void enterLevel(const StaticMenuItemDef* submenu);
+
+    /**
+     * @brief Returns to the enclosing level, restoring its cursor position. At the root level, the navigation
+     *        leaves the flash menu (if it was entered from another menu).
+     * @return false if already at the root level
+     */
+    virtual bool leaveLevel();
+
+    uint8_t getDepth() {return depth;};
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include "VirtualMenu.h"
+
+void VirtualMenuItem::printText(Print& out) {
+    if (owner->printItemText!=NULL) owner->printItemText(index, out, owner->callbackArgument);
+}
+
+bool VirtualMenuItem::update(menu_event_t event) {
+    if (owner->selectCallback!=NULL) {
+        bool returnValue = owner->selectCallback(index, owner->callbackArgument);
+        if (!returnValue) requestRedraw();
+        return returnValue;
+    }
+    return false;
+}
+
+MenuItem* VirtualMenu::getItem(uint16_t index) {
+    if (index>=maxCount) return NULL;
+    item.setIndex(index);
+    return &item;
+}
+
+void VirtualMenu::setCount(uint16_t count) {
+    maxCount = count;
+    if (selectedItem>=maxCount) selectedItem = maxCount>0 ? maxCount-1 : 0;
+    if (scrollOffset>selectedItem) scrollOffset = selectedItem;
+    itemsChanged();
+}
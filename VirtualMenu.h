@@ -0,0 +1,70 @@
+#ifndef VIRTUAL_MENU_H
+#define VIRTUAL_MENU_H
+#include <Arduino.h>
+#include "Menu.h"
+
+class VirtualMenu;
+
+/**
+ * @class VirtualMenuItem
+ * @file VirtualMenu.h
+ * @brief The single item object of a VirtualMenu. It is pointed at a different list index for every row that is drawn or updated.
+ */
+class VirtualMenuItem: public MenuItem {
+protected:
+    VirtualMenu* owner;
+    uint16_t index;
+public:
+    VirtualMenuItem(VirtualMenu* owner):
+        MenuItem(""), owner(owner), index(0) { };
+    void setIndex(uint16_t newIndex) {index = newIndex;};
+    uint16_t getIndex() {return index;};
+    virtual void printText(Print& out);
+    virtual bool update(menu_event_t event);
+};
+
+/**
+ * @class VirtualMenu
+ * @file VirtualMenu.h
+ * @brief Menu whose entries are generated on demand, for long lists such as file names, log entries or preset banks.
+ *        The list is described by a count and a callback providing the text of an entry; only the rows in view are ever
+ *        generated, so memory use does not depend on the length of the list (up to 65535 entries).
+ *        Call itemsChanged() when the text of entries changed, so that rows in view are generated again.
+ */
+class VirtualMenu: public Menu {
+protected:
+    void (*printItemText)(uint16_t index, Print& out, void* argument);
+    bool (*selectCallback)(uint16_t index, void* argument);
+    void* callbackArgument;
+    VirtualMenuItem item;
+    
+    friend class VirtualMenuItem;
+public:
+    /**
+     * @brief Constructor for a virtual menu.
+     * @param count Number of entries in the list
+     * @param printItemText Callback printing the text of entry index to out (the display or a bounded buffer; text beyond the
+     *        display width is dropped)
+     * @param selectCallback Optional callback when an entry is selected. Like an ActionMenuItem callback, it is called repeatedly
+     *        until it returns false.
+     * @param callbackArgument optional void pointer argument passed to the callbacks
+     * @param name Name of the menu (shown when used as an item of another menu)
+     * @param rollover activates roll-over at the top and bottom of the menu
+     * @param menuLines number of lines that fit on the display.
+     */
+    VirtualMenu(uint16_t count, void (*printItemText)(uint16_t, Print&, void*), bool (*selectCallback)(uint16_t, void*)=NULL, void* callbackArgument=NULL,
+        char* name="", bool rollover=false, uint8_t menuLines=4):
+    Menu(NULL, count, name, rollover, menuLines), printItemText(printItemText), selectCallback(selectCallback), callbackArgument(callbackArgument), item(this)
+    {};
+    
+    virtual MenuItem* getItem(uint16_t index);
+    
+    /**
+     * @brief Changes the length of the list (e.g. after re-reading a directory). Keeps the cursor inside the list and redraws.
+     */
+    void setCount(uint16_t count);
+    
+    uint16_t getCount() {return maxCount;};
+};
+
+#endif
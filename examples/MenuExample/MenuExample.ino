@@ -3,6 +3,9 @@
 #include <ButtonPress.h>
 #include <parameters.h>
 #include <AnalogKnob.h>
+#include <MenuTask.h>
+#include <MenuWatch.h>
+#include <MenuRunner.h>
 
 // ----- Hardware setup -------
 
@@ -15,6 +18,9 @@
 // Defining the Display 
 #define I2C_ADDRESS 0x3C
 SSD1306AsciiWire display;   //(Text mode)
+
+// Instance for the menu visualisation
+MenuDisplay menuDisplay = MenuDisplay(&display);
  
 // De-bounced button event handlers with 300ms repeat period and 100ms de-bounce filter time
 ButtonPress upButton = ButtonPress(B_UP, 300, 100);
@@ -39,27 +45,36 @@ AnalogKnob knob = AnalogKnob(0, 5);
 
 /** Callback for LED parameter
  */
-void updateLED(ParameterInt16* param) {
+void updateLED(ParameterBool* param) {
     pinMode(LED_BUILTIN, OUTPUT);
-    if (param->getValue()>0) {
+    if (param->getValue()) {
         digitalWrite(LED_BUILTIN, HIGH);
     } else {
         digitalWrite(LED_BUILTIN, LOW);
     }
 }
 
-/** an action that uses the display and runs until user clicks "back" button
+// runs long actions in slices between menu input and display updates
+MenuScheduler scheduler;
+
+/** an action that uses the display and runs until user clicks "back" button.
+ *  It draws one frame per tick and returns, so buttons, knob and parameters keep working meanwhile.
  */
-bool updateActionItem(void* argument) {
-  int counter = 0;
-  int pos=50;
-  int dir=1;
-  display.clear();
-  while (true) {
-    // if the return or select button is pushed, return false to stop and go back to the menu
-    menu_event_t event = buttonEvent();
-    if ((event==MENU_LEAVE)||(event==MENU_SELECT)) return false;
-    
+class BounceTask: public MenuTask {
+  int counter;
+  int pos;
+  int dir;
+public:
+  BounceTask(): MenuTask(2000) {};
+
+  virtual void begin() {
+    counter = 0;
+    pos = 50;
+    dir = 1;
+    display.clear();
+  }
+
+  virtual task_result_t step() {
     display.setCursor(pos,2);
     display.println(" O ");
     display.setCursor(10,6*2);
@@ -68,8 +83,23 @@ bool updateActionItem(void* argument) {
     counter++;
     pos+=dir;
     if ((pos>110) || (pos<1)) dir *= -1;
+    return TASK_YIELD; // next frame on the next loop
+  }
+
+  // stopped by the select or return button (handled by the TaskMenuItem)
+  virtual void end(task_state_t reason) {
+    menuDisplay.invalidate(); // we have drawn over the menu, so it has to be repainted completely
   }
-  return false;
+};
+BounceTask bounceTask;
+
+// refreshes live values (watch items) on the screen, at most every 100ms
+MenuWatcher watcher;
+
+/** getter for a watch item: time since start in tenths of a second
+ */
+int32_t uptime(void* argument) {
+  return millis()/100;
 }
 
 // ------------ Defining the menu structure ---------------
@@ -81,7 +111,15 @@ BackMenuItem backMenuItem = BackMenuItem("back...");
 ParameterInt16 pVal1("Value 0-10", 0, 0, 10, 1);
 ParameterInt16 pVal2("Value 0-100", 50, 0, 100, 1);
 ParameterInt16 pVal3("Value 0-500", 0, 0, 500, 10);
-ParameterInt16 pSwitch1("LED", 0, 0, 1, 1, updateLED); // value with callback (updateLED)
+ParameterBool pSwitch1("LED", false, updateLED); // on/off value with callback (updateLED)
+ParameterFixed<1> pGain("Gain", 10, 0, 250, 5); // 0.0 to 25.0 in steps of 0.5
+
+// choice parameter, with its labels in flash
+const char modeSlow[] PROGMEM = "slow";
+const char modeNormal[] PROGMEM = "normal";
+const char modeFast[] PROGMEM = "fast";
+const char* const modeLabels[] PROGMEM = {modeSlow, modeNormal, modeFast};
+ParameterEnum pMode("Mode", 1, modeLabels, 3);
 
 
 
@@ -91,10 +129,12 @@ MenuItem* valueMenuItems[] = {
   new ParamMenuItem("Value 0-100", &pVal2, &knob), 
   new ParamMenuItem("Value 0-500", &pVal3, &knob), 
   new ParamMenuItem("LED ", &pSwitch1), 
+  new ParamMenuItem("Gain ", &pGain, &knob), 
+  new ParamMenuItem("Mode ", &pMode), 
   &backMenuItem // optional for 4-button control, needed for 3-button
 };
 // Value submenu
-Menu valueMenu(valueMenuItems, 5, "Values");
+Menu valueMenu(valueMenuItems, 7, "Values");
 
 // Nested submenu example
 MenuItem* subSubMenuItems[] = {
@@ -108,10 +148,11 @@ Menu subSubMenu(subSubMenuItems, 4, "Sub-sub-menu");
 MenuItem* subMenuItems[] = {
   &subSubMenu,  // we can use a Menu as MenuItem, using the default name of the Menu
   new SubMenuItem("SubValues", &valueMenu), // or we can create a new SubMenuItem to give it a different name
-  new ActionMenuItem("Action", &updateActionItem), 
+  new TaskMenuItem("Action", &bounceTask, &scheduler), 
+  new WatchMenuItem("Uptime", uptime, NULL, 500, 5, 1), // live value, read every 500ms and shown in steps of 0.5s
   &backMenuItem // optional for 4-button control, needed for 3-button
 };
-Menu subMenu(subMenuItems, 4, "Sub-Menu");
+Menu subMenu(subMenuItems, 5, "Sub-Menu");
 
 // a long menu, to demonstrate scrolling
 MenuItem* longMenuItems[] = {
@@ -132,26 +173,29 @@ Menu longMenu(longMenuItems, 9, "Long menu", true); // initialise long menu with
 MenuItem* mainMenuItems[] = 
   { (MenuItem*)&valueMenu,
     (MenuItem*)&subMenu, 
-    new ActionMenuItem("Action", &updateActionItem),
+    new TaskMenuItem("Action", &bounceTask, &scheduler),
     (MenuItem*)&longMenu, 
    };
 
 Menu mainMenu = Menu(mainMenuItems, 4, "Main menu", false);
 
-// Instance for the menu visualisation
-MenuDisplay menuDisplay = MenuDisplay(&display);
 
+// main loop driver: polls the buttons every 2ms and draws at most 25 frames per second, in slices of 1.5ms between the polls,
+// so buttons stay responsive during a full repaint and fast input does not cause one frame per event
+MenuRunner<MenuDisplay> runner(&mainMenu, &menuDisplay, buttonEvent);
 
 void setup() {
   // Initialise Display in text mode
   Wire.begin();
   Wire.setClock(400000L);
   display.begin(&Adafruit128x64, I2C_ADDRESS);
+  // update live values after each input poll
+  runner.setWatcher(&watcher);
+  // give running actions their time slice, and leave the display to them while they run
+  runner.setScheduler(&scheduler);
 }
 
 void loop() {
-  // visualize the currently active submenu on the display
-  menuDisplay.updateDisplay(mainMenu.getCurrentSubmenu());
-  // run the menu navigation, based on the button events
-  MenuItem* selectedItem = mainMenu.navigateMenu(buttonEvent());
+  // input, navigation, actions and the display, each at its own rate
+  runner.run();
 }
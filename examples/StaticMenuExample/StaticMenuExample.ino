@@ -0,0 +1,81 @@
+#include <Menu.h>
+#include <StaticMenu.h>
+#include <MenuDisplay.h>
+#include <ButtonPress.h>
+#include <parameters.h>
+#include <AnalogKnob.h>
+
+// Menu tree defined at compile time: item counts are computed by makeMenu, and the whole
+// structure including all names is kept in flash (PROGMEM). Only the navigation state is in RAM.
+
+// ----- Hardware setup -------
+
+#define B_UP   5
+#define B_DOWN 7
+#define B_LEFT 6
+#define B_RIGHT 2
+
+#define I2C_ADDRESS 0x3C
+SSD1306AsciiWire display;   //(Text mode)
+
+ButtonPress upButton = ButtonPress(B_UP, 300, 100);
+ButtonPress downButton = ButtonPress(B_DOWN, 300, 100);
+ButtonPress leftButton = ButtonPress(B_LEFT, 0, 200);
+ButtonPress rightButton = ButtonPress(B_RIGHT, 0, 200);
+
+menu_event_t buttonEvent() {
+  if (upButton.pushed()) return MENU_UP;
+  if (downButton.pushed()) return MENU_DOWN;
+  if (leftButton.pushed()) return MENU_LEAVE;
+  if (rightButton.pushed()) return MENU_SELECT;
+  return NONE;
+}
+
+AnalogKnob knob = AnalogKnob(0, 5);
+
+void updateLED(ParameterInt16* param) {
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, param->getValue()>0 ? HIGH : LOW);
+}
+
+// parameters live in RAM, as their values change
+ParameterInt16 pVal1("Value 0-10", 0, 0, 10, 1);
+ParameterInt16 pVal2("Value 0-100", 50, 0, 100, 1);
+ParameterInt16 pSwitch1("LED", 0, 0, 1, 1, updateLED);
+
+// ------------ Defining the menu structure (in flash) ---------------
+// submenus have to be declared before the menus that refer to them
+
+const auto valueMenu PROGMEM = makeMenu("Values",
+  menuParam("Value 0- 10", &pVal1, &knob),
+  menuParam("Value 0-100", &pVal2, &knob),
+  menuParam("LED ", &pSwitch1),
+  menuBack()
+);
+
+const auto longMenu PROGMEM = makeMenu("Long menu",
+  menuText("Item1"), menuText("Item2"), menuText("Item3"), menuText("Item4"),
+  menuText("Item5"), menuText("Item6"), menuText("Item7"), menuText("Item8"),
+  menuBack()
+);
+
+const auto rootMenu PROGMEM = makeMenu("Main menu",
+  menuSubmenu("Values", valueMenu),
+  menuSubmenu("More values", valueMenu), // the same submenu can be reached from several places
+  menuSubmenu("Long menu", longMenu)
+);
+
+FlashMenu mainMenu(rootMenu);
+
+MenuDisplay menuDisplay = MenuDisplay(&display);
+
+void setup() {
+  Wire.begin();
+  Wire.setClock(400000L);
+  display.begin(&Adafruit128x64, I2C_ADDRESS);
+}
+
+void loop() {
+  menuDisplay.updateDisplay(mainMenu.getCurrentSubmenu());
+  mainMenu.navigateMenu(buttonEvent());
+}
@@ -0,0 +1,62 @@
+#include "HostFileStorage.h"
+#include <stdlib.h>
+#include <string.h>
+
+HostFileStorage::HostFileStorage(const char* path, uint16_t size): size(size), writes(0) {
+    data = (uint8_t*)malloc(size);
+    cellWrites = (uint32_t*)calloc(size, sizeof(uint32_t));
+    memset(data, 0xFF, size);
+    file = fopen(path, "r+b");
+    if (file!=NULL) {
+        size_t found = fread(data, 1, size, file);
+        (void)found;
+    } else {
+        file = fopen(path, "w+b");
+    }
+    if (file!=NULL) {
+        fseek(file, 0, SEEK_SET);
+        fwrite(data, 1, size, file);
+        fflush(file);
+    }
+}
+
+HostFileStorage::~HostFileStorage() {
+    if (file!=NULL) fclose(file);
+    free(data);
+    free(cellWrites);
+}
+
+void HostFileStorage::write(uint16_t address, uint8_t value) {
+    if (address>=size) return;
+    data[address] = value;
+    cellWrites[address]++;
+    writes++;
+    if (file!=NULL) {
+        fseek(file, address, SEEK_SET);
+        fputc(value, file);
+    }
+}
+
+void HostFileStorage::commit() {
+    if (file!=NULL) fflush(file);
+}
+
+void HostFileStorage::erase() {
+    memset(data, 0xFF, size);
+    if (file!=NULL) {
+        fseek(file, 0, SEEK_SET);
+        fwrite(data, 1, size, file);
+        fflush(file);
+    }
+}
+
+uint32_t HostFileStorage::getMaxCellWrites() {
+    uint32_t maximum = 0;
+    for (uint16_t i=0; i<size; i++) if (cellWrites[i]>maximum) maximum = cellWrites[i];
+    return maximum;
+}
+
+void HostFileStorage::resetCounters() {
+    memset(cellWrites, 0, size*sizeof(uint32_t));
+    writes = 0;
+}
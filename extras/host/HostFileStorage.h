@@ -0,0 +1,48 @@
+#ifndef HOST_FILE_STORAGE_H
+#define HOST_FILE_STORAGE_H
+
+#include "Arduino.h"
+#include <ParameterStore.h>
+#include <stdio.h>
+
+/**
+ * @class HostFileStorage
+ * @file HostFileStorage.h
+ * @brief EEPROM stand-in for ParameterStore, backed by a file so that contents survive a restart of the program
+ *        (a "power cycle"). A new file starts erased (0xFF). Every write goes to the file right away, and the writes
+ *        per address are counted to show the wear of the cells.
+ */
+class HostFileStorage: public ParameterStorage {
+private:
+    FILE* file;
+    uint16_t size;
+    uint8_t* data;
+    uint32_t* cellWrites;
+    uint32_t writes;
+public:
+    /**
+     * @param path file holding the memory contents (created if missing)
+     * @param size memory size in bytes, e.g. 1024 as on an ATmega328
+     */
+    HostFileStorage(const char* path, uint16_t size=1024);
+    ~HostFileStorage();
+
+    virtual uint16_t length() {return size;};
+    virtual uint8_t read(uint16_t address) {return (address<size) ? data[address] : 0xFF;};
+    virtual void write(uint16_t address, uint8_t value);
+    virtual void commit();
+
+    /**
+     * @brief Sets all bytes to 0xFF, as a new or erased EEPROM.
+     */
+    void erase();
+
+    uint32_t getWrites() {return writes;};
+    /**
+     * @brief Highest number of writes to a single address: the wear of the most used cell.
+     */
+    uint32_t getMaxCellWrites();
+    void resetCounters();
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "HostHal.h"
+#include <stdio.h>
+
+static uint32_t virtualMicros = 0;
+static uint8_t pinLevel[NUM_DIGITAL_PINS];
+static uint8_t pinModes[NUM_DIGITAL_PINS];
+static uint16_t analogValue[NUM_ANALOG_INPUTS];
+static uint32_t analogReads = 0;
+static void (*isrTable[NUM_DIGITAL_PINS])(void);
+static int isrMode[NUM_DIGITAL_PINS];
+static void (*timerHandler)() = NULL;
+
+void HostHal::reset() {
+    virtualMicros = 0;
+    timerHandler = NULL;
+    analogReads = 0;
+    for (int i=0; i<NUM_DIGITAL_PINS; i++) {
+        pinLevel[i] = HIGH;
+        pinModes[i] = INPUT;
+        isrTable[i] = NULL;
+        isrMode[i] = 0;
+    }
+    for (int i=0; i<NUM_ANALOG_INPUTS; i++) analogValue[i] = 0;
+}
+
+void HostHal::advanceMicros(uint32_t us) {
+    virtualMicros += us;
+    if (timerHandler!=NULL) timerHandler();
+}
+
+void HostHal::setMicros(uint32_t us) {
+    virtualMicros = us;
+    if (timerHandler!=NULL) timerHandler();
+}
+
+void HostHal::setTimerHandler(void (*handler)()) {
+    timerHandler = handler;
+}
+
+void HostHal::setPin(uint8_t pin, uint8_t level) {
+    if (pin>=NUM_DIGITAL_PINS) return;
+    uint8_t old = pinLevel[pin];
+    pinLevel[pin] = level ? HIGH : LOW;
+    if ((isrTable[pin]!=NULL) && (old!=pinLevel[pin])) {
+        bool fire = (isrMode[pin]==CHANGE)
+            || ((isrMode[pin]==RISING) && (pinLevel[pin]==HIGH))
+            || ((isrMode[pin]==FALLING) && (pinLevel[pin]==LOW));
+        if (fire) isrTable[pin]();
+    }
+}
+
+uint8_t HostHal::getPin(uint8_t pin) {
+    return pin<NUM_DIGITAL_PINS ? pinLevel[pin] : LOW;
+}
+
+void HostHal::setAnalog(uint8_t channel, uint16_t value) {
+    if (channel<NUM_ANALOG_INPUTS) analogValue[channel] = value>1023 ? 1023 : value;
+}
+
+uint32_t HostHal::getAnalogReads() {
+    return analogReads;
+}
+
+// ---- Arduino core functions backed by the simulated hardware ----
+
+unsigned long millis(void) {return virtualMicros/1000UL;}
+unsigned long micros(void) {return virtualMicros;}
+void delay(unsigned long ms) {HostHal::advanceMicros(ms*1000UL);}
+void delayMicroseconds(unsigned int us) {HostHal::advanceMicros(us);}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin<NUM_DIGITAL_PINS) pinModes[pin] = mode;
+}
+
+int digitalRead(uint8_t pin) {
+    return pin<NUM_DIGITAL_PINS ? pinLevel[pin] : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if ((pin<NUM_DIGITAL_PINS) && (pinModes[pin]==OUTPUT)) pinLevel[pin] = value ? HIGH : LOW;
+}
+
+int analogRead(uint8_t pin) {
+    analogReads++;
+    return pin<NUM_ANALOG_INPUTS ? analogValue[pin] : 0;
+}
+
+void attachInterrupt(int8_t interruptNum, void (*isr)(void), int mode) {
+    if ((interruptNum<0) || (interruptNum>=NUM_DIGITAL_PINS)) return;
+    isrTable[interruptNum] = isr;
+    isrMode[interruptNum] = mode;
+}
+
+void detachInterrupt(int8_t interruptNum) {
+    if ((interruptNum<0) || (interruptNum>=NUM_DIGITAL_PINS)) return;
+    isrTable[interruptNum] = NULL;
+}
+
+char* ltoa(long value, char* str, int base) {
+    char tmp[34];
+    int i = 0;
+    bool negative = (value<0) && (base==10);
+    unsigned long v = negative ? -(unsigned long)value : (unsigned long)value;
+    if ((base<2) || (base>36)) {str[0] = 0; return str;}
+    do {
+        int d = v % base;
+        tmp[i++] = d<10 ? '0'+d : 'a'+d-10;
+        v /= base;
+    } while (v>0);
+    int j = 0;
+    if (negative) str[j++] = '-';
+    while (i>0) str[j++] = tmp[--i];
+    str[j] = 0;
+    return str;
+}
+
+char* itoa(int value, char* str, int base) {
+    // AVR int is 16 bit: non-decimal bases print the 16-bit two's complement pattern
+    if (base!=10) return ltoa((long)(uint16_t)value, str, base);
+    return ltoa(value, str, base);
+}
@@ -0,0 +1,50 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include "Arduino.h"
+
+/**
+ * @class HostHal
+ * @file HostHal.h
+ * @brief Controls the simulated hardware behind the host Arduino shim: a virtual clock
+ *        that only moves when told to, digital pin levels, analog input values and attached interrupts.
+ */
+class HostHal {
+public:
+    /**
+     * @brief Reset clock, pins and interrupts to power-on state (all inputs idle high, analog 0).
+     */
+    static void reset();
+
+    /**
+     * @brief Advance the virtual clock. millis() and micros() only change through this call (or delay()).
+     * @param us Time step in microseconds
+     */
+    static void advanceMicros(uint32_t us);
+    static void advanceMillis(uint32_t ms) {advanceMicros(ms*1000UL);};
+    static void setMicros(uint32_t us);
+
+    /**
+     * @brief Register a function that is called whenever the virtual clock moves, like a timer interrupt
+     *        (used by simulated peripherals such as HostI2CTransport). NULL removes it.
+     */
+    static void setTimerHandler(void (*handler)());
+
+    /**
+     * @brief Set the level seen by digitalRead(). Fires an attached interrupt if the edge matches its mode.
+     */
+    static void setPin(uint8_t pin, uint8_t level);
+    static uint8_t getPin(uint8_t pin);
+
+    /**
+     * @brief Set the value returned by analogRead() for a channel (0..1023).
+     */
+    static void setAnalog(uint8_t channel, uint16_t value);
+
+    /**
+     * @brief Number of analogRead() conversions performed since reset.
+     */
+    static uint32_t getAnalogReads();
+};
+
+#endif
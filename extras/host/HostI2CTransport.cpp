@@ -0,0 +1,45 @@
+#include "HostI2CTransport.h"
+#include "HostHal.h"
+
+HostI2CTransport* HostI2CTransport::instance = NULL;
+
+void HostI2CTransport::timer() {
+    if (instance!=NULL) instance->service();
+}
+
+void HostI2CTransport::attach() {
+    instance = this;
+    HostHal::setTimerHandler(timer);
+}
+
+void HostI2CTransport::transmit(uint8_t address, const uint8_t* data, uint8_t length) {
+    // a packet started from the completion of the previous one follows it directly on the bus
+    uint32_t start = servicing ? doneAt : micros();
+    uint32_t duration = (uint32_t)(((uint64_t)(length+1)*9 + 2)*1000000ULL/clock);
+    doneAt = start + duration;
+    active = true;
+    bytes += length+1;
+    transactions++;
+    busMicros += duration;
+}
+
+void HostI2CTransport::service() {
+    if (servicing) return;
+    servicing = true;
+    while (active && ((int32_t)(micros()-doneAt)>=0)) {
+        active = false;
+        owner->transmitComplete();
+    }
+    servicing = false;
+}
+
+void HostI2CTransport::wait() {
+    if (!active) return;
+    uint32_t now = micros();
+    if ((int32_t)(doneAt-now)>0) {
+        waitMicros += doneAt-now;
+        HostHal::setMicros(doneAt);
+    } else {
+        service();
+    }
+}
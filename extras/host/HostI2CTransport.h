@@ -0,0 +1,54 @@
+#ifndef HOST_I2C_TRANSPORT_H
+#define HOST_I2C_TRANSPORT_H
+
+#include "Arduino.h"
+#include <SSD1306AsciiQueued.h>
+
+/**
+ * @class HostI2CTransport
+ * @file HostI2CTransport.h
+ * @brief Simulated interrupt-driven I2C controller for SSD1306AsciiQueued. A packet occupies the bus for its transfer time
+ *        at the configured clock (9 clocks per byte including the address, plus start/stop), and completes from the
+ *        HostHal timer handler once the virtual clock has passed that time. Packets queued meanwhile follow back to back.
+ *        wait() moves the clock to the end of the current transfer, as a CPU spinning on a full queue would.
+ *        Only one instance can be attached at a time.
+ */
+class HostI2CTransport: public DisplayTransport {
+private:
+    uint32_t clock;
+    bool active;
+    bool servicing;
+    uint32_t doneAt;
+    uint32_t bytes;
+    uint32_t transactions;
+    uint32_t busMicros;
+    uint32_t waitMicros;
+
+    static HostI2CTransport* instance;
+    static void timer();
+public:
+    HostI2CTransport(uint32_t clock=400000UL):
+    clock(clock), active(false), servicing(false), doneAt(0), bytes(0), transactions(0), busMicros(0), waitMicros(0) {};
+
+    /**
+     * @brief Registers the completion handler with the virtual clock.
+     */
+    void attach();
+
+    virtual void transmit(uint8_t address, const uint8_t* data, uint8_t length);
+    virtual void wait();
+
+    /**
+     * @brief Completes transfers whose time has passed (called from the timer handler).
+     */
+    void service();
+
+    bool isBusy() {return active;};
+    uint32_t getBytes() {return bytes;};               // bus bytes including address bytes
+    uint32_t getTransactions() {return transactions;};
+    uint32_t getBusMicros() {return busMicros;};       // time the bus was busy
+    uint32_t getWaitMicros() {return waitMicros;};     // time the CPU spent in wait()
+    void resetCounters() {bytes = 0; transactions = 0; busMicros = 0; waitMicros = 0;};
+};
+
+#endif
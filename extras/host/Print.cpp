@@ -0,0 +1,72 @@
+#include "Arduino.h"
+#include <stdio.h>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (write(*buffer++)) n++;
+        else break;
+    }
+    return n;
+}
+
+size_t Print::write(const char* str) {
+    if (str==NULL) return 0;
+    return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::print(const __FlashStringHelper* str) {return write((const char*)str);}
+size_t Print::print(const char* str) {return write(str);}
+size_t Print::print(char c) {return write((uint8_t)c);}
+size_t Print::print(unsigned char n, int base) {return print((unsigned long)n, base);}
+size_t Print::print(int n, int base) {return print((long)n, base);}
+size_t Print::print(unsigned int n, int base) {return print((unsigned long)n, base);}
+
+size_t Print::print(long n, int base) {
+    if (base==0) return write((uint8_t)n);
+    if ((base==10) && (n<0)) {
+        size_t t = print('-');
+        return printNumber(-(unsigned long)n, 10) + t;
+    }
+    return printNumber((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    if (base==0) return write((uint8_t)n);
+    return printNumber(n, base);
+}
+
+size_t Print::print(double number, int digits) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", digits, number);
+    return write(buf);
+}
+
+size_t Print::println(void) {return write("\r\n");}
+size_t Print::println(const __FlashStringHelper* str) {size_t n = print(str); return n + println();}
+size_t Print::println(const char* str) {size_t n = print(str); return n + println();}
+size_t Print::println(char c) {size_t n = print(c); return n + println();}
+size_t Print::println(int n, int base) {size_t r = print(n, base); return r + println();}
+size_t Print::println(unsigned int n, int base) {size_t r = print(n, base); return r + println();}
+size_t Print::println(long n, int base) {size_t r = print(n, base); return r + println();}
+size_t Print::println(unsigned long n, int base) {size_t r = print(n, base); return r + println();}
+size_t Print::println(double n, int digits) {size_t r = print(n, digits); return r + println();}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+    char buf[8*sizeof(long)+1];
+    char* str = &buf[sizeof(buf)-1];
+    *str = '\0';
+    if (base<2) base = 10;
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = c<10 ? c+'0' : c+'A'-10;
+    } while (n);
+    return write(str);
+}
+
+HostSerial Serial;
+
+size_t HostSerial::write(uint8_t c) {
+    return putchar(c)==EOF ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+#include "SSD1306Ascii.h"
+
+static uint16_t fontSize(const uint8_t* font) {
+    return (pgm_read_byte(font + FONT_LENGTH) << 8) | pgm_read_byte(font + FONT_LENGTH + 1);
+}
+
+void SSD1306Ascii::init(const DevType* dev) {
+    m_col = 0;
+    m_row = 0;
+    m_displayWidth = dev->lcdWidth;
+    m_displayHeight = dev->lcdHeight;
+    m_colOffset = dev->colOffset;
+    for (uint8_t i=0; i<dev->initSize; i++) ssd1306WriteCmd(pgm_read_byte(dev->initcmds + i));
+    clear();
+}
+
+void SSD1306Ascii::clear() {
+    clear(0, displayWidth() - 1, 0, displayRows() - 1);
+}
+
+void SSD1306Ascii::clear(uint8_t c0, uint8_t c1, uint8_t r0, uint8_t r1) {
+    if (r1 >= displayRows()) r1 = displayRows() - 1;
+    for (uint8_t r = r0; r <= r1; r++) {
+        setCursor(c0, r);
+        for (uint8_t c = c0; c <= c1; c++) ssd1306WriteRamBuf(0);
+    }
+    setCursor(c0, r0);
+}
+
+void SSD1306Ascii::clearToEOL() {
+    clear(m_col, displayWidth() - 1, m_row, m_row + fontRows() - 1);
+}
+
+void SSD1306Ascii::clearField(uint8_t col, uint8_t row, uint8_t n) {
+    setCursor(col, row);
+    for (uint8_t i = 0; i < n; i++) write(' ');
+    setCursor(col, row);
+}
+
+uint8_t SSD1306Ascii::fontHeight() {
+    return m_font ? pgm_read_byte(m_font + FONT_HEIGHT) : 0;
+}
+
+uint8_t SSD1306Ascii::fontWidth() {
+    return m_font ? pgm_read_byte(m_font + FONT_FIXED_WIDTH) : 0;
+}
+
+uint8_t SSD1306Ascii::charWidth(uint8_t c) {
+    if (!m_font) return 0;
+    uint8_t first = pgm_read_byte(m_font + FONT_FIRST_CHAR);
+    uint8_t count = pgm_read_byte(m_font + FONT_CHAR_COUNT);
+    if ((c < first) || (c >= first + count)) return 0;
+    if (fontSize(m_font) > 1) return pgm_read_byte(m_font + FONT_WIDTH_TABLE + c - first);
+    return pgm_read_byte(m_font + FONT_FIXED_WIDTH);
+}
+
+size_t SSD1306Ascii::strWidth(const char* str) {
+    size_t sw = 0;
+    while (*str) {
+        uint8_t cw = charWidth(*str++);
+        if (cw == 0) return 0;
+        sw += cw + letterSpacing();
+    }
+    return sw;
+}
+
+void SSD1306Ascii::setCursor(uint8_t col, uint8_t row) {
+    setCol(col);
+    setRow(row);
+}
+
+void SSD1306Ascii::setCol(uint8_t col) {
+    if (col < m_displayWidth) {
+        m_col = col;
+        col += m_colOffset;
+        ssd1306WriteCmd(SSD1306_SETLOWCOLUMN | (col & 0xF));
+        ssd1306WriteCmd(SSD1306_SETHIGHCOLUMN | (col >> 4));
+    }
+}
+
+void SSD1306Ascii::setRow(uint8_t row) {
+    if (row < displayRows()) {
+        m_row = row;
+        ssd1306WriteCmd(SSD1306_SETSTARTPAGE | m_row);
+    }
+}
+
+void SSD1306Ascii::ssd1306WriteRam(uint8_t c) {
+    if (m_col < m_displayWidth) {
+        writeDisplay(c ^ m_invertMask, SSD1306_MODE_RAM);
+        m_col++;
+    }
+}
+
+void SSD1306Ascii::ssd1306WriteRamBuf(uint8_t c) {
+    if (m_col < m_displayWidth) {
+        writeDisplay(c ^ m_invertMask, SSD1306_MODE_RAM_BUF);
+        m_col++;
+    }
+}
+
+size_t SSD1306Ascii::write(uint8_t ch) {
+    if (!m_font) return 0;
+    uint8_t w = pgm_read_byte(m_font + FONT_FIXED_WIDTH);
+    uint8_t h = pgm_read_byte(m_font + FONT_HEIGHT);
+    uint8_t nr = (h + 7)/8;
+    uint8_t first = pgm_read_byte(m_font + FONT_FIRST_CHAR);
+    uint8_t count = pgm_read_byte(m_font + FONT_CHAR_COUNT);
+    const uint8_t* base = m_font + FONT_WIDTH_TABLE;
+
+    if ((ch < first) || (ch >= first + count)) {
+        if (ch == '\r') {setCol(0); return 1;}
+        if (ch == '\n') {setCol(0); setRow(m_row + nr); return 1;}
+        return 0;
+    }
+    ch -= first;
+    uint8_t s = letterSpacing();
+    uint8_t thieleShift = 0;
+    if (fontSize(m_font) < 2) {
+        base += nr*w*ch;
+    } else {
+        if (h & 7) thieleShift = 8 - (h & 7);
+        uint16_t index = 0;
+        for (uint8_t i = 0; i < ch; i++) index += pgm_read_byte(base + i);
+        w = pgm_read_byte(base + ch);
+        base += nr*index + count;
+    }
+    uint8_t scol = m_col;
+    uint8_t srow = m_row;
+    for (uint8_t r = 0; r < nr; r++) {
+        if (r) setCursor(scol, m_row + 1);
+        for (uint8_t c = 0; c < w; c++) {
+            uint8_t b = pgm_read_byte(base + c + r*w);
+            if (thieleShift && (r + 1 == nr)) b >>= thieleShift;
+            ssd1306WriteRamBuf(b);
+        }
+        for (uint8_t i = 0; i < s; i++) ssd1306WriteRamBuf(0);
+    }
+    setRow(srow);
+    setCol(scol + w + s);
+    return 1;
+}
+
+static const uint8_t SSD1306_128x64_init[] = {
+    0xAE, 0xD5, 0x80, 0xA8, 0x3F, 0xD3, 0x00, 0x40, 0x8D, 0x14, 0x20, 0x02,
+    0xA1, 0xC8, 0xDA, 0x12, 0x81, 0xCF, 0xD9, 0xF1, 0xDB, 0x40, 0xA4, 0xA6, 0xAF
+};
+static const uint8_t SSD1306_128x32_init[] = {
+    0xAE, 0xD5, 0x80, 0xA8, 0x1F, 0xD3, 0x00, 0x40, 0x8D, 0x14, 0x20, 0x02,
+    0xA1, 0xC8, 0xDA, 0x02, 0x81, 0x8F, 0xD9, 0xF1, 0xDB, 0x40, 0xA4, 0xA6, 0xAF
+};
+
+const DevType Adafruit128x64 = {SSD1306_128x64_init, sizeof(SSD1306_128x64_init), 128, 64, 0};
+const DevType Adafruit128x32 = {SSD1306_128x32_init, sizeof(SSD1306_128x32_init), 128, 32, 0};
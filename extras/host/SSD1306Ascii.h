@@ -0,0 +1,92 @@
+#ifndef HOST_SSD1306ASCII_H
+#define HOST_SSD1306ASCII_H
+// Host stand-in for the SSD1306Ascii text-mode driver. The cursor, font and clearing logic
+// follows the real library so that the same command and RAM byte stream is produced; the
+// bytes are handed to writeDisplay() of a transport subclass (see SSD1306AsciiWire.h).
+
+#include "Arduino.h"
+
+#define SSD1306_MODE_CMD 0
+#define SSD1306_MODE_RAM 1
+#define SSD1306_MODE_RAM_BUF 2
+
+#define SSD1306_SETLOWCOLUMN 0x00
+#define SSD1306_SETHIGHCOLUMN 0x10
+#define SSD1306_SETSTARTPAGE 0xB0
+
+// font header layout used by SSD1306Ascii (and GLCD) fonts
+#define FONT_LENGTH 0
+#define FONT_FIXED_WIDTH 2
+#define FONT_HEIGHT 3
+#define FONT_FIRST_CHAR 4
+#define FONT_CHAR_COUNT 5
+#define FONT_WIDTH_TABLE 6
+
+struct DevType {
+    const uint8_t* initcmds;
+    uint8_t initSize;
+    uint8_t lcdWidth;
+    uint8_t lcdHeight;
+    uint8_t colOffset;
+};
+
+extern const DevType Adafruit128x64;
+extern const DevType Adafruit128x32;
+
+extern const uint8_t Arial_bold_14[];
+extern const uint8_t System5x7[];
+
+class SSD1306Ascii: public Print {
+public:
+    SSD1306Ascii(): m_col(0), m_row(0), m_displayWidth(128), m_displayHeight(64), m_colOffset(0),
+        m_letterSpacing(1), m_invertMask(0), m_font(NULL) {};
+
+    void clear();
+    void clear(uint8_t c0, uint8_t c1, uint8_t r0, uint8_t r1);
+    void clearToEOL();
+    void clearField(uint8_t col, uint8_t row, uint8_t n);
+
+    uint8_t col() {return m_col;};
+    uint8_t row() {return m_row;};
+    uint8_t displayWidth() {return m_displayWidth;};
+    uint8_t displayHeight() {return m_displayHeight;};
+    uint8_t displayRows() {return m_displayHeight/8;};
+
+    const uint8_t* font() {return m_font;};
+    uint8_t fontHeight();
+    uint8_t fontRows() {return (fontHeight()+7)/8;};
+    uint8_t fontWidth();
+    uint8_t charWidth(uint8_t c);
+    size_t strWidth(const char* str);
+    uint8_t letterSpacing() {return m_letterSpacing;};
+    void setLetterSpacing(uint8_t pixels) {m_letterSpacing = pixels;};
+
+    void setCursor(uint8_t col, uint8_t row);
+    void setCol(uint8_t col);
+    void setRow(uint8_t row);
+    void setFont(const uint8_t* font) {m_font = font;};
+    void setInvertMode(bool mode) {m_invertMask = mode ? 0xFF : 0;};
+    bool invertMode() {return m_invertMask!=0;};
+
+    void ssd1306WriteCmd(uint8_t c) {writeDisplay(c, SSD1306_MODE_CMD);};
+    void ssd1306WriteRam(uint8_t c);
+    void ssd1306WriteRamBuf(uint8_t c);
+
+    virtual size_t write(uint8_t c);
+    using Print::write;
+
+protected:
+    void init(const DevType* dev);
+    virtual void writeDisplay(uint8_t b, uint8_t mode) = 0;
+
+    uint8_t m_col;
+    uint8_t m_row;
+    uint8_t m_displayWidth;
+    uint8_t m_displayHeight;
+    uint8_t m_colOffset;
+    uint8_t m_letterSpacing;
+    uint8_t m_invertMask;
+    const uint8_t* m_font;
+};
+
+#endif
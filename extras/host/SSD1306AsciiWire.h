@@ -0,0 +1,58 @@
+#ifndef HOST_SSD1306ASCIIWIRE_H
+#define HOST_SSD1306ASCIIWIRE_H
+
+#include <Wire.h>
+#include "SSD1306Ascii.h"
+
+/**
+ * @class SSD1306AsciiWire
+ * @file SSD1306AsciiWire.h
+ * @brief I2C transport of the host display stand-in. Mirrors the OPTIMIZE_I2C packing of the real
+ *        library (up to 16 RAM bytes per transaction, one transaction per command) on the counting Wire stub,
+ *        so Wire.getBytes()/getTransactions() report the traffic a real SSD1306 would see.
+ */
+class SSD1306AsciiWire: public SSD1306Ascii {
+public:
+    SSD1306AsciiWire(): m_i2cAddr(0x3C), m_nData(0) {};
+    void begin(const DevType* dev, uint8_t i2cAddr) {
+        m_i2cAddr = i2cAddr;
+        m_nData = 0;
+        init(dev);
+    };
+    void setI2cClock(uint32_t frequency) {Wire.setClock(frequency);};
+
+    /**
+     * @brief Number of RAM (glyph) bytes written since the last resetCounters().
+     */
+    uint32_t getRamBytes() {return m_ramBytes;};
+    uint32_t getCmdBytes() {return m_cmdBytes;};
+    void resetCounters() {m_ramBytes = 0; m_cmdBytes = 0; Wire.resetCounters();};
+
+protected:
+    virtual void writeDisplay(uint8_t b, uint8_t mode) {
+        if ((m_nData > 16) || (m_nData && (mode == SSD1306_MODE_CMD))) {
+            Wire.endTransmission();
+            m_nData = 0;
+        }
+        if (m_nData == 0) {
+            Wire.beginTransmission(m_i2cAddr);
+            Wire.write(mode == SSD1306_MODE_CMD ? 0x00 : 0x40);
+        }
+        Wire.write(b);
+        if (mode == SSD1306_MODE_CMD) m_cmdBytes++; else m_ramBytes++;
+        if (mode == SSD1306_MODE_RAM_BUF) {
+            m_nData++;
+        } else {
+            Wire.endTransmission();
+            m_nData = 0;
+        }
+    };
+
+private:
+    uint8_t m_i2cAddr;
+    uint8_t m_nData;
+    uint32_t m_ramBytes = 0;
+    uint32_t m_cmdBytes = 0;
+};
+
+#endif
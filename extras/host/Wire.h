@@ -0,0 +1,63 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+#include "HostHal.h"
+
+/**
+ * @class TwoWire
+ * @file Wire.h
+ * @brief Host stand-in for the Arduino Wire library. Nothing is transmitted; instead every
+ *        transaction and byte that would go over the bus is counted, including the address byte.
+ */
+class TwoWire: public Print {
+private:
+    uint32_t clock;
+    uint32_t bytes;
+    uint32_t transactions;
+    uint32_t transactionBytes;
+    bool transmitting;
+    bool blocking;
+public:
+    TwoWire(): clock(100000UL), bytes(0), transactions(0), transactionBytes(0), transmitting(false), blocking(false) {};
+    void begin() {};
+    void setClock(uint32_t frequency) {clock = frequency;};
+    uint32_t getClock() {return clock;};
+
+    void beginTransmission(uint8_t address) {transmitting = true; bytes++; transactionBytes = 1;};
+    uint8_t endTransmission(bool stop = true) {
+        if (transmitting) {
+            transactions++;
+            // like the real Wire library, return only when the transaction is on the bus
+            if (blocking) HostHal::advanceMicros((uint32_t)(((uint64_t)transactionBytes*9 + 2)*1000000ULL/clock));
+        }
+        transmitting = false;
+        return 0;
+    };
+    virtual size_t write(uint8_t b) {bytes++; transactionBytes++; return 1;};
+    using Print::write;
+
+    /**
+     * @brief Bytes on the bus since the last resetCounters(), including address bytes.
+     */
+    uint32_t getBytes() {return bytes;};
+    /**
+     * @brief Completed transactions (START .. STOP) since the last resetCounters().
+     */
+    uint32_t getTransactions() {return transactions;};
+    /**
+     * @brief Estimated time on the bus at the configured clock: 9 clocks per byte plus start/stop.
+     */
+    uint32_t getBusMicros() {return (uint32_t)(((uint64_t)bytes*9 + transactions*2)*1000000ULL/clock);};
+    void resetCounters() {bytes = 0; transactions = 0;};
+
+    /**
+     * @brief When set, every transaction advances the virtual clock by its bus time, so that micros() sees the
+     *        loop blocking on I2C as on hardware. Off by default.
+     */
+    void setBlocking(bool block) {blocking = block;};
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,714 @@
+// Host benchmark for the Menu library: navigation cost, display traffic per frame and
+// worst-case redraw cost, measured against the counting SSD1306AsciiWire/Wire stand-ins.
+//
+//   make bench
+
+#include "HostHal.h"
+#include <Menu.h>
+#include <MenuDisplay.h>
+#include <VirtualMenu.h>
+#include <ButtonPress.h>
+#include <ButtonBank.h>
+#include <parameters.h>
+#include <SSD1306AsciiQueued.h>
+#include <MenuGraphicsDisplay.h>
+#include <MenuWatch.h>
+#include <RotaryEncoder.h>
+#include <ParameterStore.h>
+#include <MenuStats.h>
+#include <MenuRunner.h>
+#include "HostI2CTransport.h"
+#include "HostFileStorage.h"
+
+#include <stdio.h>
+#include <chrono>
+
+static SSD1306AsciiWire display;
+
+static double nowNs() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct FrameStats {
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t transactions;
+    uint32_t worstBytes;
+    uint32_t worstTransactions;
+    uint32_t worstBusMicros;
+
+    FrameStats(): frames(0), bytes(0), transactions(0), worstBytes(0), worstTransactions(0), worstBusMicros(0) {};
+
+    void add() {
+        frames++;
+        bytes += Wire.getBytes();
+        transactions += Wire.getTransactions();
+        if (Wire.getBytes()>worstBytes) {
+            worstBytes = Wire.getBytes();
+            worstTransactions = Wire.getTransactions();
+            worstBusMicros = Wire.getBusMicros();
+        }
+    };
+};
+
+// menu_event_t sequence walking the cursor to the end of the menu and back
+static menu_event_t sweepEvent(uint32_t step, uint16_t count) {
+    uint32_t period = 2*(uint32_t)count;
+    return (step % period) < count ? MENU_DOWN : MENU_UP;
+}
+
+static void virtualItemText(uint16_t index, Print& out, void* argument) {
+    out.print("Item ");
+    out.print(index);
+}
+
+// fixtures are intentionally never freed, the benchmark is a short-lived process
+class MenuFixture {
+public:
+    uint16_t count;
+    Menu* menu;
+
+    MenuFixture(uint16_t count, bool generated): count(count) {
+        if (generated) {
+            menu = new VirtualMenu(count, virtualItemText, NULL, NULL, "Bench");
+            return;
+        }
+        MenuItem** items = new MenuItem*[count];
+        char (*names)[12] = new char[count][12];
+        for (uint16_t i=0; i<count; i++) {
+            snprintf(names[i], 12, "Item %u", i);
+            items[i] = new MenuItem(names[i]);
+        }
+        menu = new Menu(items, count, "Bench");
+    };
+};
+
+static void benchNavigation(uint16_t count, bool generated) {
+    const uint32_t iterations = 200000;
+    MenuFixture fixture(count, generated);
+    Menu* menu = fixture.menu;
+
+    // navigation only (no rendering)
+    double start = nowNs();
+    for (uint32_t i=0; i<iterations; i++) {
+        menu->navigateMenu(sweepEvent(i, fixture.count));
+    }
+    double navNs = (nowNs()-start)/iterations;
+
+    // navigation plus rendering, one frame per event
+    display.clear();
+    MenuDisplay menuDisplay(&display);
+    menu->requestRedraw();
+    menuDisplay.updateDisplay(menu->getCurrentSubmenu());
+    FrameStats stats;
+    uint32_t frames = 4*(uint32_t)fixture.count;
+    double renderNs = 0;
+    for (uint32_t i=0; i<frames; i++) {
+        menu->navigateMenu(sweepEvent(i, fixture.count));
+        display.resetCounters();
+        double t0 = nowNs();
+        menuDisplay.updateDisplay(menu->getCurrentSubmenu());
+        renderNs += nowNs()-t0;
+        stats.add();
+    }
+
+    // full repaint, e.g. after entering a submenu or after an action drew over the screen
+    menuDisplay.invalidate();
+    menu->requestRedraw();
+    display.resetCounters();
+    menuDisplay.updateDisplay(menu->getCurrentSubmenu());
+    uint32_t fullBytes = Wire.getBytes();
+    uint32_t fullBusMicros = Wire.getBusMicros();
+
+    printf("%6u %-7s %10.1f %10.1f %10.1f %8.1f %8u %8u %9u %8u %9u\n",
+        count, generated ? "virtual" : "items",
+        navNs, renderNs/frames,
+        (double)stats.bytes/stats.frames, (double)stats.transactions/stats.frames,
+        stats.worstBytes, stats.worstTransactions, stats.worstBusMicros,
+        fullBytes, fullBusMicros);
+}
+
+static uint32_t burstCallbacks = 0;
+
+static void countCallback(ParameterInt16* parameter) {
+    burstCallbacks++;
+}
+
+// a burst of 8 auto-repeat events, applied one frame per event or batched into one frame
+static void benchBurst(bool batched) {
+    ParameterInt16 parameter("Value", 0, 0, 1000, 1, countCallback);
+    MenuItem* items[] = {new ParamMenuItem("Value", &parameter), new MenuItem("Item1"), new MenuItem("Item2"), new MenuItem("Item3")};
+    Menu menu(items, 4, "Burst");
+    display.clear();
+    MenuDisplay menuDisplay(&display);
+    menuDisplay.updateDisplay(&menu);
+    menu.navigateMenu(MENU_SELECT);
+    menuDisplay.updateDisplay(&menu);
+
+    const uint8_t burst = 8;
+    uint32_t redraws = 0;
+    burstCallbacks = 0;
+    display.resetCounters();
+    for (uint8_t pass=0; pass<2; pass++) {
+        // first up, then the cursor down in the menu (after leaving the parameter)
+        menu_event_t event = pass==0 ? MENU_UP : MENU_DOWN;
+        if (pass==1) {
+            menu.navigateMenu(MENU_SELECT);
+            menuDisplay.updateDisplay(&menu);
+        }
+        if (batched) {
+            menu_event_t events[burst];
+            for (uint8_t i=0; i<burst; i++) events[i] = event;
+            menu.navigateMenu(events, burst);
+            if (menu.needsRedraw()) redraws++;
+            menuDisplay.updateDisplay(&menu);
+        } else {
+            for (uint8_t i=0; i<burst; i++) {
+                menu.navigateMenu(event);
+                if (menu.needsRedraw()) redraws++;
+                menuDisplay.updateDisplay(&menu);
+            }
+        }
+    }
+    printf("%-9s value %4d, cursor %u: %2u redraws, %2u callbacks, %5u bytes\n", batched ? "batched" : "per event",
+        parameter.getValue(), menu.getSelectedItem(), redraws, burstCallbacks, Wire.getBytes());
+}
+
+// full repaint split into slices: worst time a single updateDisplay call blocks the loop (I2C time on the virtual clock)
+static void benchBudget(uint16_t budgetMicros) {
+    MenuFixture fixture(64, false);
+    Menu* menu = fixture.menu;
+    MenuDisplay menuDisplay(&display);
+    Wire.setBlocking(true);
+    uint32_t calls = 0;
+    uint32_t worst = 0;
+    uint32_t total = 0;
+    for (uint8_t frame=0; frame<8; frame++) {
+        // page down: every line changes
+        for (uint8_t i=0; i<4; i++) menu->navigateMenu(MENU_DOWN);
+        bool done = false;
+        while (!done) {
+            uint32_t start = micros();
+            done = menuDisplay.updateDisplay(menu, budgetMicros);
+            uint32_t elapsed = micros()-start;
+            if (elapsed>worst) worst = elapsed;
+            total += elapsed;
+            calls++;
+        }
+    }
+    Wire.setBlocking(false);
+    printf("budget %5u us: %5.1f calls/frame, worst call %5u us, frame %6u us\n",
+        budgetMicros, calls/8.0, worst, total/8);
+}
+
+// page-down frames: blocking Wire transactions against the queued display drained by a simulated I2C interrupt
+static void benchQueued() {
+    const uint8_t frames = 16;
+    MenuFixture fixture(64, false);
+    Menu* menu = fixture.menu;
+
+    // blocking: the loop waits for every transaction
+    HostHal::reset();
+    MenuDisplay blockingDisplay(&display);
+    blockingDisplay.updateDisplay(menu);
+    Wire.setBlocking(true);
+    display.resetCounters();
+    uint32_t blocked = 0;
+    for (uint8_t frame=0; frame<frames; frame++) {
+        for (uint8_t i=0; i<4; i++) menu->navigateMenu(MENU_DOWN);
+        uint32_t start = micros();
+        blockingDisplay.updateDisplay(menu);
+        blocked += micros()-start;
+    }
+    Wire.setBlocking(false);
+    printf("%-9s %8.1f %8.1f %10.1f %10.1f %7s\n", "Wire",
+        (double)Wire.getBytes()/frames, (double)Wire.getTransactions()/frames, (double)blocked/frames, (double)Wire.getBusMicros()/frames, "-");
+
+    // queued: the loop only fills transmit buffers, and waits only when the ring is full
+    menu->moveBy(-(int16_t)fixture.count);
+    HostHal::reset();
+    HostI2CTransport transport(400000UL);
+    transport.attach();
+    SSD1306AsciiQueued queued;
+    queued.begin(&Adafruit128x64, 0x3C, &transport);
+    MenuDisplay queuedDisplay(&queued);
+    menu->requestRedraw();
+    queuedDisplay.updateDisplay(menu);
+    queued.waitIdle();
+    transport.resetCounters();
+    queued.resetCounters();
+    blocked = 0;
+    for (uint8_t frame=0; frame<frames; frame++) {
+        for (uint8_t i=0; i<4; i++) menu->navigateMenu(MENU_DOWN);
+        uint32_t start = micros();
+        queuedDisplay.updateDisplay(menu);
+        blocked += micros()-start;
+        // the rest of the loop runs while the frame is sent
+        while (!queued.isIdle()) HostHal::advanceMicros(100);
+    }
+    HostHal::setTimerHandler(NULL);
+    printf("%-9s %8.1f %8.1f %10.1f %10.1f %7.1f\n", "queued",
+        (double)transport.getBytes()/frames, (double)transport.getTransactions()/frames, (double)blocked/frames,
+        (double)transport.getBusMicros()/frames, (double)queued.getStalls()/frames);
+}
+
+// edits on a menu of parameters: cursor moves, entering/leaving edit mode and value changes
+static const menu_event_t editScript[] = {MENU_DOWN, MENU_SELECT, MENU_UP, MENU_UP, MENU_DOWN, MENU_SELECT, MENU_DOWN, MENU_DOWN};
+
+template<class Display>
+static void measureEdits(const char* label, Display& menuDisplay, Menu* menu, bool fullFrames) {
+    const uint16_t frames = 64;
+    menuDisplay.updateDisplay(menu);
+    Wire.resetCounters();
+    for (uint16_t frame=0; frame<frames; frame++) {
+        menu->navigateMenu(editScript[frame % (sizeof(editScript)/sizeof(editScript[0]))]);
+        if (fullFrames) menuDisplay.invalidate();
+        menuDisplay.updateDisplay(menu);
+    }
+    printf("%-18s %8.1f %8.1f %10.1f\n", label,
+        (double)Wire.getBytes()/frames, (double)Wire.getTransactions()/frames, (double)Wire.getBusMicros()/frames);
+}
+
+static void benchGraphics() {
+    const uint8_t count = 16;
+    MenuItem** items = new MenuItem*[count];
+    char (*names)[12] = new char[count][12];
+    for (uint8_t i=0; i<count; i++) {
+        snprintf(names[i], 12, "Gain %u", i);
+        items[i] = new ParamMenuItem(names[i], new ParameterInt16(names[i], 50, 0, 100, 5));
+    }
+    Menu menu(items, count, "Graphics", true);
+
+    MenuDisplay textDisplay(&display);
+    measureEdits("text", textDisplay, &menu, false);
+    SSD1306WireDriver driver;
+    driver.begin(&Adafruit128x64, 0x3C);
+    MenuGraphicsDisplay<SSD1306WireDriver> graphicsDisplay(&driver);
+    measureEdits("framebuffer", graphicsDisplay, &menu, false);
+    measureEdits("framebuffer, full", graphicsDisplay, &menu, true);
+    printf("framebuffer: %u column ranges, %u data bytes\n",
+        graphicsDisplay.getFramebuffer().getWrites(), graphicsDisplay.getFramebuffer().getBytesSent());
+}
+
+static uint32_t formattedValues = 0;
+
+class CountingParameter: public ParameterInt16 {
+public:
+    CountingParameter(char* aname): ParameterInt16(aname, 0, 0, 30000, 1) {};
+    virtual size_t printValue(Print& out) {formattedValues++; return ParameterInt16::printValue(out);};
+};
+
+// one parameter edited continuously (as by a knob) next to three that do not change
+template<class Display>
+static void measureKnobEdit(const char* label, Display& menuDisplay) {
+    const uint16_t frames = 1000;
+    MenuItem* items[8];
+    for (uint8_t i=0; i<8; i++) items[i] = new ParamMenuItem("Param", new CountingParameter("Param"));
+    Menu menu(items, 8, "Knob");
+    menu.navigateMenu(MENU_SELECT);
+    menuDisplay.updateDisplay(&menu);
+    formattedValues = 0;
+    Wire.resetCounters();
+    double start = nowNs();
+    for (uint16_t frame=0; frame<frames; frame++) {
+        menu.navigateMenu(MENU_UP);
+        menuDisplay.updateDisplay(&menu);
+    }
+    double frameNs = (nowNs()-start)/frames;
+    printf("%-18s %10.2f %10.0f %8.1f\n", label, (double)formattedValues/frames, frameNs, (double)Wire.getBytes()/frames);
+}
+
+static void benchRowCache() {
+    MenuDisplay textDisplay(&display);
+    measureKnobEdit("text", textDisplay);
+    SSD1306WireDriver driver;
+    driver.begin(&Adafruit128x64, 0x3C);
+    MenuGraphicsDisplay<SSD1306WireDriver> graphicsDisplay(&driver);
+    measureKnobEdit("framebuffer", graphicsDisplay);
+}
+
+static volatile int32_t watchCounter;
+static volatile int16_t watchNoisy;
+static volatile int16_t watchConstant = 42;
+
+// status screen at 1 kHz loop rate: a fast counter, a noisy reading and a constant, four rows of each kind in a row
+static void benchWatch(uint16_t refreshMillis, uint16_t watchInterval) {
+    const uint32_t loops = 5000;
+    WatchMenuItem* items[4] = {
+        new WatchMenuItem("Count", &watchCounter, refreshMillis),
+        new WatchMenuItem("Noisy", &watchNoisy, refreshMillis, refreshMillis>0 ? 5 : 1),
+        new WatchMenuItem("Const", &watchConstant, refreshMillis),
+        new WatchMenuItem("Count", &watchCounter, refreshMillis, 1, 2)
+    };
+    Menu menu((MenuItem**)items, 4, "Status");
+    MenuWatcher watcher(watchInterval);
+    MenuDisplay menuDisplay(&display);
+    HostHal::reset();
+    menuDisplay.updateDisplay(&menu);
+    Wire.resetCounters();
+    uint32_t frames = 0;
+    srand(1);
+    for (uint32_t loop=0; loop<loops; loop++) {
+        HostHal::advanceMillis(1);
+        watchCounter++;
+        watchNoisy = 500 + rand()%5;
+        menu.navigateMenu(NONE);
+        watcher.poll(&menu);
+        if (menu.needsRedraw()) frames++;
+        menuDisplay.updateDisplay(&menu);
+    }
+    double seconds = loops/1000.0;
+    printf("%-9u %-9u %10.1f %10.0f %10.1f\n", refreshMillis, watchInterval, frames/seconds, Wire.getBytes()/seconds,
+        100.0*Wire.getBusMicros()/(seconds*1e6));
+}
+
+static uint32_t sweepCallbacks = 0;
+static int16_t sweepDelivered = 0;
+
+static void sweepCallback(ParameterInt16* parameter) {
+    sweepCallbacks++;
+    sweepDelivered = parameter->getValue();
+}
+
+// a knob swept over the range for one second while the parameter is edited, then the edit is committed
+static void benchDispatch(const char* label, ParameterDispatcher* dispatcher) {
+    ParameterInt16 parameter("Sweep", 0, 0, 1000, 1, sweepCallback);
+    parameter.setDispatcher(dispatcher);
+    MenuItem* items[] = {new ParamMenuItem("Sweep", &parameter)};
+    Menu menu(items, 1, "Dispatch");
+    HostHal::reset();
+    menu.navigateMenu(MENU_SELECT);
+    sweepCallbacks = 0;
+    for (uint16_t loop=0; loop<1000; loop++) {
+        HostHal::advanceMillis(1);
+        menu.navigateMenu(MENU_UP);
+        if (dispatcher!=NULL) dispatcher->run();
+    }
+    uint32_t duringEdit = sweepCallbacks;
+    menu.navigateMenu(MENU_SELECT);
+    printf("%-20s %10u %10u %10d\n", label, duringEdit, sweepCallbacks, sweepDelivered);
+    // the dispatcher outlives the parameter
+    parameter.setDispatcher(NULL);
+}
+
+static uint32_t editCallbacks = 0;
+
+static void editCallback(ParameterInt16* parameter) {
+    editCallbacks++;
+}
+
+// the 0-500 parameter of the example (step 10) edited from 0 to 500, as a 1 kHz loop sees it
+static void printEdit(const char* label, uint32_t inputs, uint32_t ms, uint32_t redraws, int16_t value) {
+    printf("%-22s %8u %8u %8u %8u %6d\n", label, inputs, ms, redraws, editCallbacks, value);
+}
+
+static void benchEncoder(const char* label, uint16_t detentsPerSecond) {
+    ParameterInt16 parameter("Value", 0, 0, 500, 10, editCallback);
+    MenuItem* items[] = {new ParamMenuItem("Value", &parameter)};
+    Menu menu(items, 1, "Encoder");
+    HostHal::reset();
+    RotaryEncoder encoder(2, 3);
+    if (detentsPerSecond==0) encoder.setAcceleration(0, 1);
+    encoder.begin();
+    menu.navigateMenu(MENU_SELECT);
+    editCallbacks = 0;
+    // levels of A and B for the four states of a detent in the positive direction
+    static const uint8_t levelsA[4] = {LOW, LOW, HIGH, HIGH};
+    static const uint8_t levelsB[4] = {HIGH, LOW, LOW, HIGH};
+    uint32_t quarterMicros = 250000UL/(detentsPerSecond>0 ? detentsPerSecond : 5);
+    uint32_t nextEdge = quarterMicros, edges = 0, redraws = 0, ms = 0;
+    for (ms=1; (ms<=20000) && (parameter.getValue()<500); ms++) {
+        while (nextEdge<=ms*1000UL) {
+            HostHal::setMicros(nextEdge);
+            HostHal::setPin(2, levelsA[edges & 3]);
+            HostHal::setPin(3, levelsB[edges & 3]);
+            edges++;
+            nextEdge += quarterMicros;
+        }
+        HostHal::setMicros(ms*1000UL);
+        menu.navigateBy(encoder.read(menu.getCurrentSubmenu()->isActivated()));
+        if (menu.getCurrentSubmenu()->needsRedraw()) {
+            redraws++;
+            items[0]->doneRedraw();
+        }
+    }
+    encoder.end();
+    printEdit(label, edges/4, ms-1, redraws, parameter.getValue());
+}
+
+static void benchHeldButton() {
+    ParameterInt16 parameter("Value", 0, 0, 500, 10, editCallback);
+    MenuItem* items[] = {new ParamMenuItem("Value", &parameter)};
+    Menu menu(items, 1, "Buttons");
+    HostHal::reset();
+    ButtonPress button(5, 300, 100);
+    menu.navigateMenu(MENU_SELECT);
+    editCallbacks = 0;
+    HostHal::setPin(5, LOW);
+    uint32_t events = 0, redraws = 0, ms = 0;
+    for (ms=1; (ms<=20000) && (parameter.getValue()<500); ms++) {
+        HostHal::setMicros(ms*1000UL);
+        menu_event_t event = button.pushed() ? MENU_UP : NONE;
+        if (event!=NONE) events++;
+        menu.navigateMenu(event);
+        if (menu.getCurrentSubmenu()->needsRedraw()) {
+            redraws++;
+            items[0]->doneRedraw();
+        }
+    }
+    printEdit("button held, 300 ms", events, ms-1, redraws, parameter.getValue());
+}
+
+// saving on every callback, as in a sketch that calls EEPROM.update from the parameter callback
+static HostFileStorage* naiveStorage = NULL;
+
+static void naiveSave(ParameterInt16* parameter) {
+    int16_t value = parameter->getValue();
+    const uint8_t* bytes = (const uint8_t*)&value;
+    for (uint8_t b=0; b<2; b++) {
+        if (naiveStorage->read(b)!=bytes[b]) naiveStorage->write(b, bytes[b]);
+    }
+}
+
+// 300 edits: a value swept for 1 s at 1 kHz, then left alone for 3 s
+static void benchPersistence(bool useStore) {
+    HostFileStorage storage(BENCH_BUILD_DIR "/bench_eeprom.bin");
+    storage.erase();
+    storage.resetCounters();
+    naiveStorage = &storage;
+    ParameterInt16 level("Level", 0, 0, 1000, 1, useStore ? NULL : naiveSave);
+    ParameterInt16 offset("Offset", 0, -500, 500, 1);
+    ParameterBool enable("Enable", false);
+    ParameterStore store(&storage);
+    store.add(&level);
+    store.add(&offset);
+    store.add(&enable);
+    HostHal::reset();
+    for (uint16_t edit=0; edit<300; edit++) {
+        enable.setValue(edit & 1);
+        for (uint16_t ms=0; ms<4000; ms++) {
+            HostHal::advanceMillis(1);
+            if (ms<1000) level.incrementBy((edit & 1) ? -1 : 1);
+            if (useStore) store.run();
+        }
+    }
+    int16_t saved = level.getValue();
+    bool restored = false;
+    if (useStore) {
+        // power cycle: new parameters with their defaults, restored from the file
+        HostFileStorage restart(BENCH_BUILD_DIR "/bench_eeprom.bin");
+        ParameterInt16 level2("Level", 0, 0, 1000, 1);
+        ParameterInt16 offset2("Offset", 0, -500, 500, 1);
+        ParameterBool enable2("Enable", false);
+        ParameterStore store2(&restart);
+        store2.add(&level2);
+        store2.add(&offset2);
+        store2.add(&enable2);
+        restored = store2.restore() && (level2.getValue()==saved) && (enable2.getValue()==enable.getValue());
+    }
+    printf("%-16s %8u %8u %8u %8u %9s\n", useStore ? "store, 2 s idle" : "every callback", useStore ? store.getSaves() : 0,
+        storage.getWrites(), storage.getMaxCellWrites(), useStore ? store.getSlots() : 1, useStore ? (restored ? "ok" : "FAILED") : "-");
+}
+
+// scripted input for the main loop comparison: MENU_DOWN every 5 ms during the first second, one event per poll
+static uint32_t inputPolls, inputLastPoll, inputMaxGap, inputDelivered, inputLagTotal, inputMaxLag;
+
+static menu_event_t scriptedInput() {
+    uint32_t now = micros();
+    if ((inputPolls>0) && (now-inputLastPoll>inputMaxGap)) inputMaxGap = now-inputLastPoll;
+    inputLastPoll = now;
+    inputPolls++;
+    uint32_t due = now/5000;
+    if (due>200) due = 200;
+    if (inputDelivered>=due) return NONE;
+    uint32_t lag = now-(inputDelivered+1)*5000UL;
+    inputLagTotal += lag;
+    if (lag>inputMaxLag) inputMaxLag = lag;
+    inputDelivered++;
+    return MENU_DOWN;
+}
+
+// 2 s of main loop (50 us of other work per iteration, blocking I2C): render and navigate back to back, or a MenuRunner
+static void benchRunner(bool useRunner) {
+    MenuFixture fixture(256, false);
+    Menu* menu = fixture.menu;
+    MenuDisplay menuDisplay(&display);
+    MenuRunner<MenuDisplay> runner(menu, &menuDisplay, scriptedInput);
+    HostHal::reset();
+    menuDisplay.updateDisplay(menu);
+    Wire.setBlocking(true);
+    Wire.resetCounters();
+    inputPolls = inputLastPoll = inputMaxGap = inputDelivered = inputLagTotal = inputMaxLag = 0;
+    uint32_t frames = 0;
+    while (micros()<2000000UL) {
+        if (useRunner) {
+            runner.run();
+        } else {
+            if (menu->needsRedraw()) frames++;
+            menuDisplay.updateDisplay(menu);
+            menu->navigateMenu(scriptedInput());
+        }
+        HostHal::advanceMicros(50);
+    }
+    Wire.setBlocking(false);
+    if (useRunner) frames = runner.getFrames();
+    printf("%-14s %8u %9u %8u %9.0f %9u %8u %8u %8u\n", useRunner ? "MenuRunner" : "back to back", inputPolls, inputMaxGap,
+        frames, inputDelivered>0 ? (double)inputLagTotal/inputDelivered : 0.0, inputMaxLag, Wire.getBytes(),
+        runner.getMissedInputs(), runner.getMissedFrames());
+}
+
+#if MENU_STATS
+// 3 s of a 1 kHz loop scrolling through a list with a held button (blocking I2C), as recorded by MenuStats
+static void benchStats() {
+    MenuFixture fixture(64, false);
+    Menu* menu = fixture.menu;
+    MenuDisplay menuDisplay(&display);
+    HostHal::reset();
+    ButtonPress down(7, 200, 50);
+    Wire.setBlocking(true);
+    menuDisplay.updateDisplay(menu);
+    MenuStats::reset();
+    while (millis()<3000) {
+        HostHal::advanceMillis(1);
+        // held for 1 s out of every 1.5 s
+        HostHal::setPin(7, (millis()%1500<1000) ? LOW : HIGH);
+        menu->navigateMenu(down.pushed() ? MENU_DOWN : NONE);
+        menuDisplay.updateDisplay(menu, 2000);
+    }
+    Wire.setBlocking(false);
+    MenuStats::dump(Serial);
+}
+#endif
+
+static void benchButtons() {
+    const uint32_t iterations = 1000000;
+    HostHal::reset();
+    ButtonPress button(5, 300, 100);
+    uint32_t events = 0;
+    double start = nowNs();
+    for (uint32_t i=0; i<iterations; i++) {
+        // hold the button for one second out of every two, advancing 100us per poll
+        HostHal::setPin(5, ((i/10000) & 1) ? LOW : HIGH);
+        HostHal::advanceMicros(100);
+        if (button.pushed()) events++;
+    }
+    double ns = (nowNs()-start)/iterations;
+    printf("ButtonPress::pushed: %.1f ns per call (%u events in %u polls)\n", ns, events, iterations);
+
+    // four buttons polled every loop: separate ButtonPress objects against one ButtonBank
+    HostHal::reset();
+    ButtonPress presses[4] = {ButtonPress(5, 300, 100), ButtonPress(6, 300, 100), ButtonPress(7, 300, 100), ButtonPress(8, 300, 100)};
+    events = 0;
+    start = nowNs();
+    for (uint32_t i=0; i<iterations; i++) {
+        HostHal::setPin(5, ((i/10000) & 1) ? LOW : HIGH);
+        HostHal::advanceMicros(100);
+        for (uint8_t b=0; b<4; b++) if (presses[b].pushed()) events++;
+    }
+    double pressNs = (nowNs()-start)/iterations;
+
+    HostHal::reset();
+    static const uint8_t pins[] = {5, 6, 7, 8};
+    ButtonBank bank(pins, 4, 5);
+    bank.setRepeat(0x0F, 400, 400);
+    uint32_t bankEvents = 0;
+    start = nowNs();
+    for (uint32_t i=0; i<iterations; i++) {
+        HostHal::setPin(5, ((i/10000) & 1) ? LOW : HIGH);
+        HostHal::advanceMicros(100);
+        bank.update();
+        uint8_t pushed = bank.getPushed();
+        while (pushed) {bankEvents += pushed & 1; pushed >>= 1;}
+    }
+    double bankNs = (nowNs()-start)/iterations;
+    printf("4 buttons per loop: ButtonPress %.1f ns (%u events), ButtonBank %.1f ns (%u events)\n", pressNs, events, bankNs, bankEvents);
+}
+
+int main() {
+    HostHal::reset();
+    Wire.begin();
+    Wire.setClock(400000L);
+    display.begin(&Adafruit128x64, 0x3C);
+
+    printf("I2C at %u Hz, %u menu lines\n\n", Wire.getClock(), 4);
+    printf("%14s %10s %10s %10s %8s %8s %8s %9s %8s %9s\n",
+        "entries", "nav ns", "frame ns", "bytes/frm", "txn/frm", "worst B", "worst tx", "worst us", "full B", "full us");
+    benchNavigation(4, false);
+    benchNavigation(64, false);
+    benchNavigation(1000, false);
+    benchNavigation(1000, true);
+    printf("\n");
+
+    printf("Burst of %u increments and %u cursor moves:\n", 8, 8);
+    benchBurst(false);
+    benchBurst(true);
+    printf("\n");
+
+    printf("Page-down repaint with blocking I2C:\n");
+    benchBudget(0);
+    benchBudget(5000);
+    benchBudget(2000);
+    printf("\n");
+
+    printf("Page-down frames, blocking Wire vs queued transmit (%u packets of %u bytes):\n", DISPLAY_QUEUE_PACKETS, DISPLAY_QUEUE_PACKET_SIZE);
+    printf("%-9s %8s %8s %10s %10s %7s\n", "backend", "B/frm", "txn/frm", "blocked us", "bus us", "stalls");
+    benchQueued();
+    printf("\n");
+
+    printf("Parameter edits, text mode vs framebuffer (dirty ranges vs full frames):\n");
+    printf("%-18s %8s %8s %10s\n", "backend", "B/frm", "txn/frm", "bus us");
+    benchGraphics();
+    printf("\n");
+
+    printf("One parameter edited per frame, %u lines shown:\n", 4);
+    printf("%-18s %10s %10s %8s\n", "backend", "rows/frm", "frame ns", "B/frm");
+    benchRowCache();
+    printf("\n");
+
+    printf("Live status rows (1 kHz loop):\n");
+    printf("%-9s %-9s %10s %10s %10s\n", "item ms", "watch ms", "frames/s", "B/s", "bus %");
+    benchWatch(0, 0);
+    benchWatch(250, 100);
+    printf("\n");
+
+    printf("Knob sweep of 1000 steps in 1 s, then commit:\n");
+    printf("%-20s %10s %10s %10s\n", "callbacks", "in edit", "total", "final");
+    benchDispatch("immediate", NULL);
+    ParameterDispatcher rateDispatcher(50, DISPATCH_RATE);
+    benchDispatch("rate 50 ms", &rateDispatcher);
+    ParameterDispatcher settleDispatcher(200, DISPATCH_SETTLE);
+    benchDispatch("settle 200 ms", &settleDispatcher);
+    ParameterDispatcher commitDispatcher(0, DISPATCH_SETTLE);
+    benchDispatch("on commit", &commitDispatcher);
+    printf("\n");
+
+    printf("Editing 0-500 in steps of 10 (1 kHz loop):\n");
+    printf("%-22s %8s %8s %8s %8s %6s\n", "input", "inputs", "ms", "redraws", "calls", "value");
+    benchHeldButton();
+    benchEncoder("encoder 5/s, no accel", 0);
+    benchEncoder("encoder 5/s", 5);
+    benchEncoder("encoder 20/s", 20);
+    benchEncoder("encoder 50/s", 50);
+    benchEncoder("encoder 200/s", 200);
+    printf("\n");
+
+    printf("EEPROM writes for 300 edits of 1000 steps each (1 KB EEPROM):\n");
+    printf("%-16s %8s %8s %8s %8s %9s\n", "saving", "records", "writes", "max cell", "slots", "restore");
+    benchPersistence(false);
+    benchPersistence(true);
+    printf("\n");
+
+    printf("Main loop, 200 page moves in 1 s then 1 s idle (%u us input tick, %u fps, %u us render budget):\n",
+        MENU_RUNNER_INPUT_INTERVAL, MENU_RUNNER_FPS, MENU_RUNNER_RENDER_BUDGET);
+    printf("%-14s %8s %9s %8s %9s %9s %8s %8s %8s\n", "loop", "polls", "max gap", "frames", "lag us", "max lag", "bytes", "miss in", "miss frm");
+    benchRunner(false);
+    benchRunner(true);
+    printf("\n");
+
+    benchButtons();
+#if MENU_STATS
+    printf("\nMenuStats of 3 s scrolling with a held button, 1 kHz loop, 2 ms display budget:\n");
+    benchStats();
+#endif
+    return 0;
+}
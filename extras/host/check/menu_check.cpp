@@ -0,0 +1,304 @@
+// Host behaviour checks for the Menu library, run against the Arduino stand-ins under the virtual clock.
+// Every check prints one line and the program exits with 1 if any of them failed.
+//
+//   make check
+
+#include "HostHal.h"
+#include <Menu.h>
+#include <MenuDisplay.h>
+#include <MenuRunner.h>
+#include <SSD1306AsciiWire.h>
+#include <parameters.h>
+#include <ParameterStore.h>
+#include <MenuStats.h>
+#include "HostFileStorage.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool failed = false;
+
+static void report(const char* name, bool ok, const char* detail) {
+    printf("%-46s %s  %s\n", name, ok ? "ok  " : "FAIL", detail);
+    if (!ok) failed = true;
+}
+
+// display stand-in that keeps a model of the SSD1306 display RAM, to compare what is on screen
+class ScreenModel: public SSD1306AsciiWire {
+public:
+    uint8_t ram[8][128];
+    uint8_t page;
+    uint8_t column;
+    bool recording;
+
+    ScreenModel(): page(0), column(0), recording(false) {memset(ram, 0, sizeof(ram));};
+
+    void start(uint8_t fill) {
+        recording = true;
+        memset(ram, fill, sizeof(ram));
+    };
+
+    virtual void writeDisplay(uint8_t b, uint8_t mode) {
+        if (recording) {
+            if (mode==SSD1306_MODE_CMD) {
+                if (b<0x10) column = (column & 0xF0) | b;
+                else if (b<0x20) column = (column & 0x0F) | ((b & 0x0F) << 4);
+                else if ((b & 0xF8)==0xB0) page = b & 7;
+            } else if (column<128) {
+                ram[page][column++] = b;
+            }
+        }
+        SSD1306AsciiWire::writeDisplay(b, mode);
+    };
+};
+
+// true if the screen equals a fresh display repainting every line of the menu over garbage
+static bool sameAsRepaint(ScreenModel& screen, Menu* menu) {
+    static ScreenModel full;
+    static bool started = false;
+    if (!started) {
+        full.begin(&Adafruit128x64, 0x3C);
+        started = true;
+    }
+    full.start(0xAA);
+    MenuDisplay reference(&full);
+    bool redraw = menu->needsRedraw();
+    menu->requestRedraw();
+    reference.updateDisplay(menu);
+    if (!redraw) menu->doneRedraw();
+    return memcmp(screen.ram, full.ram, sizeof(screen.ram))==0;
+}
+
+// random navigation, with the incremental updateDisplay interrupted at random budgets and the shadow copy dropped
+// now and then: once the display is up to date, the screen must equal a full repaint of the same menu state
+static void checkIncrementalDisplay() {
+    HostHal::reset();
+    Wire.setClock(400000L);
+    ScreenModel incremental;
+    incremental.begin(&Adafruit128x64, 0x3C);
+    incremental.start(0);
+    ParameterInt16 wide("Wide", 5, -1000, 30000, 7);
+    ParameterInt16 narrow("Narrow", 0, 0, 9, 1);
+    const char* names[] = {"Alpha", "Be", "Gamma delta epsilon zeta", "D", "Echo long name", "F", "Golf", "H"};
+    MenuItem* items[10];
+    for (uint8_t i=0; i<8; i++) items[i] = new MenuItem((char*)names[i]);
+    items[8] = new ParamMenuItem("Val", &wide);
+    items[9] = new ParamMenuItem("Sw", &narrow);
+    Menu menu(items, 10, "Check", true);
+    MenuDisplay menuDisplay(&incremental);
+    Wire.setBlocking(true);
+    srand(1);
+    uint16_t compared = 0, mismatches = 0;
+    for (uint16_t i=0; i<3000; i++) {
+        int r = rand()%10;
+        menu.navigateMenu(r<4 ? MENU_DOWN : r<7 ? MENU_UP : r<9 ? MENU_SELECT : NONE);
+        if (rand()%20==0) menuDisplay.invalidate();
+        menuDisplay.updateDisplay(&menu, 1+rand()%4000);
+        if (rand()%5!=0) continue;
+        while (!menuDisplay.updateDisplay(&menu, 1+rand()%4000)) {}
+        compared++;
+        if (!sameAsRepaint(incremental, &menu)) mismatches++;
+    }
+    Wire.setBlocking(false);
+    char detail[64];
+    snprintf(detail, sizeof(detail), "%u screens compared, %u differ", compared, mismatches);
+    report("incremental display equals full repaint", (compared>0) && (mismatches==0), detail);
+}
+
+static menu_event_t runnerEvent = NONE;
+
+static menu_event_t runnerInput() {
+    menu_event_t event = runnerEvent;
+    runnerEvent = NONE;
+    return event;
+}
+
+// runs the runner on the virtual clock with a loop() period of 100us
+static void runFor(MenuRunner<MenuDisplay>& runner, uint32_t micros) {
+    for (uint32_t t=0; t<micros; t+=100) {
+        runner.run();
+        HostHal::advanceMicros(100);
+    }
+}
+
+// the runner navigates on every input tick, which resets the redraw request of the menu: the first screen and a single
+// press between two frames must still be drawn
+static void checkRunner() {
+    HostHal::reset();
+    Wire.setClock(400000L);
+    ScreenModel screen;
+    screen.begin(&Adafruit128x64, 0x3C);
+    screen.start(0);
+    MenuItem* items[] = {new MenuItem("One"), new MenuItem("Two"), new MenuItem("Three")};
+    Menu menu(items, 3, "Runner");
+    MenuDisplay menuDisplay(&screen);
+    MenuRunner<MenuDisplay> runner(&menu, &menuDisplay, runnerInput);
+    Wire.setBlocking(true);
+    runFor(runner, 100000UL);
+    bool startup = (runner.getFrames()==1) && runner.isIdle() && sameAsRepaint(screen, &menu);
+    // one press 10ms after the frame, between two input ticks
+    runFor(runner, 10000UL);
+    runnerEvent = MENU_DOWN;
+    runFor(runner, 100000UL);
+    bool press = (runner.getFrames()==2) && runner.isIdle() && (menu.getSelectedItem()==1) && sameAsRepaint(screen, &menu);
+    Wire.setBlocking(false);
+    char detail[64];
+    snprintf(detail, sizeof(detail), "startup frame %d, press %d, %lu frames", startup, press, (unsigned long)runner.getFrames());
+    report("runner draws startup frame and single press", startup && press, detail);
+}
+
+static uint16_t heldCallbacks = 0;
+
+static void countCallback(ParameterInt16* parameter) {
+    heldCallbacks++;
+}
+
+// a value held at the end of its range reports no change, and an enum without options stays at 0
+static void checkHeldAtEnd() {
+    ParameterInt16 parameter("Held", 9, 0, 10, 1, countCallback);
+    for (uint8_t i=0; i<5; i++) parameter.increment();
+    ParameterEnum empty("Empty", 0, NULL, 0);
+    empty.incrementBy(3);
+    char detail[64];
+    snprintf(detail, sizeof(detail), "value %d, %u callbacks, empty enum %u", parameter.getValue(), heldCallbacks,
+        empty.getValue());
+    report("held values do not call back", (parameter.getValue()==10) && (heldCallbacks==1) && (empty.getValue()==0), detail);
+}
+
+// two menu trees without setNavigation() keep separate navigation stacks: leaving a submenu of one does not enter the other
+static void checkTwoRoots() {
+    MenuItem* subItemsA[] = {new MenuItem("A1")};
+    MenuItem* subItemsB[] = {new MenuItem("B1")};
+    Menu subA(subItemsA, 1, "Sub A");
+    Menu subB(subItemsB, 1, "Sub B");
+    MenuItem* itemsA[] = {new SubMenuItem("To A", &subA)};
+    MenuItem* itemsB[] = {new SubMenuItem("To B", &subB)};
+    Menu rootA(itemsA, 1, "Root A");
+    Menu rootB(itemsB, 1, "Root B");
+    rootA.navigateMenu(MENU_SELECT);
+    rootB.navigateMenu(MENU_SELECT);
+    bool entered = (rootA.getCurrentSubmenu()==&subA) && (rootB.getCurrentSubmenu()==&subB);
+    rootA.navigateMenu(MENU_LEAVE);
+    rootB.navigateMenu(MENU_LEAVE);
+    bool left = (rootA.getCurrentSubmenu()==&rootA) && (rootB.getCurrentSubmenu()==&rootB);
+    char detail[64];
+    snprintf(detail, sizeof(detail), "entered %d, left %d", entered, left);
+    report("root menus have separate navigation stacks", entered && left, detail);
+}
+
+// encoder steps past the end of a list without roll-over neither move the cursor nor request a redraw
+static void checkStepsAtEnd() {
+    MenuItem* items[] = {new MenuItem("A"), new MenuItem("B"), new MenuItem("C")};
+    Menu menu(items, 3, "Check");
+    menu.navigateBy(-5);
+    bool moved = menu.needsRedraw() && (menu.getSelectedItem()==2);
+    menu.navigateBy(-1);
+    bool heldStep = menu.needsRedraw();
+    menu_event_t burst[] = {MENU_DOWN, MENU_DOWN};
+    menu.navigateMenu(burst, 2);
+    bool heldBurst = menu.needsRedraw();
+    char detail[64];
+    snprintf(detail, sizeof(detail), "moved %d, redraw at the end: step %d, burst %d", moved, heldStep, heldBurst);
+    report("steps past the end do not redraw", moved && !heldStep && !heldBurst, detail);
+}
+
+// storage counting the bytes read
+class CountingStorage: public HostFileStorage {
+public:
+    uint32_t reads;
+
+    CountingStorage(const char* path): HostFileStorage(path, 1024), reads(0) {};
+
+    virtual uint8_t read(uint16_t address) {
+        reads++;
+        return HostFileStorage::read(address);
+    };
+};
+
+// ending an edit in a ParamMenuItem saves once with saveOnCommit, and restore reads the sequence numbers and one record
+static void checkStore() {
+    CountingStorage storage(CHECK_BUILD_DIR "/check_eeprom.bin");
+    storage.erase();
+    ParameterInt16 value("Value", 10, 0, 100, 1);
+    ParameterBool flag("Flag", false);
+    ParameterStore store(&storage);
+    store.add(&value);
+    store.add(&flag);
+    store.saveOnCommit();
+    MenuItem* items[] = {new ParamMenuItem("Value", &value)};
+    Menu menu(items, 1, "Check");
+    for (uint8_t edit=0; edit<5; edit++) {
+        menu.navigateMenu(MENU_SELECT);
+        menu.navigateMenu(MENU_UP);
+        menu.navigateMenu(MENU_UP);
+        menu.navigateMenu(MENU_SELECT);
+    }
+    store.saveOnCommit(false);
+    uint16_t saves = store.getSaves();
+
+    ParameterInt16 restoredValue("Value", 0, 0, 100, 1);
+    ParameterBool restoredFlag("Flag", true);
+    ParameterStore restored(&storage);
+    restored.add(&restoredValue);
+    restored.add(&restoredFlag);
+    storage.reads = 0;
+    bool ok = restored.restore();
+    uint32_t limit = 2*restored.getSlots() + 2*restored.getRecordSize();
+    char detail[80];
+    snprintf(detail, sizeof(detail), "%u saves, value %d, %u bytes read for %u slots", saves, restoredValue.getValue(),
+        storage.reads, restored.getSlots());
+    report("save on commit, restore from the newest slot", ok && (saves==5) && (restoredValue.getValue()==20) &&
+        !restoredFlag.getValue() && (storage.reads<=limit), detail);
+}
+
+#if MENU_STATS
+// parameter whose change takes 100 us of the virtual clock, e.g. a callback talking to hardware
+static void slowCallback(ParameterInt16* parameter) {
+    HostHal::advanceMicros(100);
+}
+
+// folded moves of a burst count as events, and stage times exclude nested stages
+static void checkStats() {
+    MenuItem* items[] = {new MenuItem("A"), new MenuItem("B"), new MenuItem("C")};
+    Menu menu(items, 3, "Check");
+    MenuStats::reset();
+    MenuEventQueue events;
+    events.push(MENU_DOWN);
+    events.push(MENU_DOWN);
+    events.push(MENU_UP);
+    menu.navigateMenu(events);
+    uint32_t burstEvents = MenuStats::getCounter(COUNT_EVENTS);
+    uint32_t burstCalls = MenuStats::getStage(STAGE_NAVIGATION).calls;
+
+    ParameterInt16 slow("Slow", 0, 0, 100, 1, slowCallback);
+    MenuItem* slowItems[] = {new ParamMenuItem("Slow", &slow)};
+    Menu slowMenu(slowItems, 1, "Check");
+    slowMenu.navigateMenu(MENU_SELECT);
+    MenuStats::reset();
+    slowMenu.navigateMenu(MENU_UP);
+    const MenuStats::Stage& navigation = MenuStats::getStage(STAGE_NAVIGATION);
+    const MenuStats::Stage& update = MenuStats::getStage(STAGE_UPDATE);
+    bool exclusive = (update.total==100) && (navigation.total==0);
+    bool counted = (burstEvents==3) && (burstCalls==1);
+    char detail[80];
+    snprintf(detail, sizeof(detail), "burst: %u events, %u nav calls; update %u us, nav %u us",
+        burstEvents, burstCalls, update.total, navigation.total);
+    report("stats count bursts, stages exclusive", counted && exclusive, detail);
+}
+#endif
+
+int main() {
+    HostHal::reset();
+    Wire.begin();
+    checkIncrementalDisplay();
+    checkStepsAtEnd();
+    checkTwoRoots();
+    checkHeldAtEnd();
+    checkRunner();
+    checkStore();
+#if MENU_STATS
+    checkStats();
+#endif
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+// Synthetic fonts for the host build. They use the SSD1306Ascii font layout (header, width table,
+// column bitmaps per page) with approximately the glyph widths of the real fonts; the bitmaps are filler.
+#include "SSD1306Ascii.h"
+
+const uint8_t Arial_bold_14[] PROGMEM = {
+    0x05, 0x80, 0x0E, 0x0E, 0x20, 0x60,
+    0x03, 0x03, 0x04, 0x07, 0x07, 0x07, 0x07, 0x03, 0x04, 0x04, 0x07, 0x07, 0x03, 0x07, 0x03, 0x04,
+    0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x03, 0x03, 0x07, 0x07, 0x07, 0x07,
+    0x07, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x0B, 0x09, 0x09,
+    0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x0B, 0x09, 0x09, 0x09, 0x04, 0x04, 0x04, 0x07, 0x07,
+    0x03, 0x07, 0x07, 0x07, 0x07, 0x07, 0x04, 0x07, 0x07, 0x03, 0x03, 0x07, 0x03, 0x0A, 0x07, 0x07,
+    0x07, 0x07, 0x07, 0x07, 0x04, 0x07, 0x07, 0x0A, 0x07, 0x07, 0x07, 0x04, 0x03, 0x04, 0x07, 0x07,
+    0x36, 0x7E, 0x8A, 0x82, 0x95, 0x25, 0xE6, 0x9B, 0xEE, 0xCB, 0xC9, 0x3C, 0x86, 0x72, 0xA1, 0xB7,
+    0x85, 0xB8, 0x4C, 0x52, 0x8C, 0x54, 0x05, 0x23, 0x3E, 0xAC, 0x0E, 0x2A, 0x8C, 0x68, 0xC3, 0xCE,
+    0xE0, 0x30, 0x39, 0xBA, 0x5C, 0x30, 0xF9, 0x63, 0x8A, 0xE7, 0x6F, 0xF8, 0x90, 0x82, 0x34, 0x3E,
+    0x2D, 0x8E, 0x8F, 0x3C, 0x0E, 0x52, 0xD2, 0x3A, 0x2F, 0xD9, 0xF5, 0x56, 0xC5, 0xE9, 0x9E, 0xF8,
+    0xEB, 0xDF, 0xD5, 0x30, 0x83, 0xF2, 0xC9, 0x78, 0xE6, 0xFA, 0x22, 0x49, 0xFA, 0x88, 0xE1, 0x09,
+    0xCF, 0xD8, 0x0A, 0xB1, 0xBC, 0xF1, 0x86, 0xB6, 0x9A, 0x60, 0x15, 0xF0, 0x83, 0x30, 0xC6, 0x32,
+    0x11, 0x62, 0x9F, 0x0C, 0x00, 0x90, 0xB7, 0x80, 0x3A, 0x11, 0x4A, 0x65, 0x00, 0x75, 0x80, 0x87,
+    0x5D, 0x7F, 0x6A, 0xA9, 0x95, 0xBC, 0x10, 0x51, 0x65, 0xBB, 0xFB, 0xC4, 0x7D, 0xC6, 0xA0, 0xF9,
+    0x10, 0x7E, 0xDB, 0xF0, 0xAD, 0x2D, 0x86, 0x34, 0x42, 0x66, 0x1B, 0x48, 0x6C, 0x84, 0xF9, 0xE5,
+    0x40, 0xC2, 0x1A, 0x36, 0x83, 0xBC, 0xD9, 0xD6, 0x41, 0xE3, 0x71, 0x2E, 0x4B, 0x58, 0x4B, 0x08,
+    0x71, 0xB4, 0x17, 0xD0, 0xEF, 0x88, 0xF0, 0xA5, 0x27, 0xBB, 0x1F, 0x31, 0x23, 0xDA, 0x3A, 0x1A,
+    0x57, 0x22, 0x00, 0x9C, 0x16, 0x45, 0xC2, 0x4C, 0x02, 0xE6, 0xEF, 0xFD, 0x0A, 0x97, 0x29, 0x8A,
+    0x7F, 0x90, 0x00, 0x78, 0x03, 0xB7, 0x39, 0x3F, 0xCB, 0xC3, 0xE4, 0x96, 0xB1, 0xAA, 0x0E, 0x81,
+    0x46, 0x90, 0x9F, 0x6E, 0xE2, 0x0D, 0x23, 0xE0, 0xAE, 0xC4, 0xD8, 0x80, 0xD6, 0x66, 0x0F, 0xC0,
+    0xF3, 0x7D, 0xC6, 0x3D, 0x71, 0x78, 0x63, 0x82, 0x26, 0x7E, 0x2E, 0xE8, 0x19, 0x0E, 0x61, 0x90,
+    0xD9, 0xEB, 0x73, 0x22, 0x26, 0x5E, 0xBE, 0xEB, 0x67, 0xC4, 0x36, 0xBA, 0xF2, 0x6F, 0xB2, 0xAA,
+    0xFE, 0x9F, 0x19, 0x59, 0xEB, 0x44, 0x8C, 0xF3, 0x9C, 0x18, 0x4E, 0x1C, 0x0F, 0x9D, 0xF8, 0xBA,
+    0x97, 0xBC, 0x59, 0x43, 0x0C, 0x6B, 0x22, 0x43, 0x74, 0x9E, 0xCE, 0xF3, 0xB3, 0x5A, 0xB3, 0x7E,
+    0xB4, 0xAB, 0xDD, 0x38, 0x07, 0x14, 0x9C, 0x8B, 0x57, 0x99, 0x65, 0x66, 0x3A, 0x73, 0xC6, 0x90,
+    0xE2, 0x39, 0xC5, 0x39, 0xE0, 0x27, 0x7B, 0x1E, 0x69, 0xC0, 0x63, 0x29, 0x43, 0xBA, 0xF4, 0x3C,
+    0x29, 0x2E, 0x76, 0x73, 0x36, 0x44, 0xF2, 0xF1, 0xA2, 0xC5, 0x21, 0xB8, 0x3E, 0xAD, 0x8B, 0x54,
+    0xE8, 0xF7, 0x32, 0xB5, 0x14, 0xE7, 0xA2, 0x07, 0x1F, 0xC0, 0x67, 0x7C, 0x35, 0xB4, 0x54, 0x8F,
+    0xDA, 0x19, 0x5B, 0x22, 0xD8, 0xAF, 0xF6, 0x60, 0xDF, 0x4E, 0xD7, 0x9A, 0x7C, 0x97, 0x6E, 0x57,
+    0x3D, 0x82, 0x7C, 0x1E, 0x68, 0x49, 0x6D, 0xC9, 0x81, 0x39, 0x77, 0x75, 0x05, 0x64, 0x9E, 0x11,
+    0x8D, 0x7B, 0x70, 0xAA, 0x45, 0x75, 0x1A, 0x8D, 0x5C, 0x01, 0xD7, 0x8C, 0xF9, 0xE7, 0x7B, 0x19,
+    0xFD, 0x4D, 0xE8, 0x6B, 0x85, 0x66, 0x9C, 0x3F, 0xFC, 0xCF, 0x0E, 0xF4, 0xA6, 0xD9, 0xA3, 0x94,
+    0xA5, 0x23, 0x07, 0xAF, 0x20, 0x7E, 0x52, 0x60, 0xE0, 0x80, 0xE3, 0xFD, 0xC6, 0xC4, 0x01, 0xCC,
+    0x79, 0x27, 0x92, 0x2F, 0x6A, 0xF6, 0xD7, 0xE8, 0xA9, 0xB8, 0xC3, 0xF2, 0x87, 0xC6, 0x8F, 0xBB,
+    0x5E, 0x09, 0x40, 0x94, 0x3E, 0xFC, 0xF9, 0x1C, 0x77, 0xF1, 0x0B, 0x1B, 0x46, 0xD3, 0x59, 0x66,
+    0x5A, 0xC5, 0x14, 0x6B, 0x97, 0x41, 0x14, 0xA7, 0xA6, 0x20, 0x69, 0x09, 0x36, 0x2B, 0x06, 0x71,
+    0xD1, 0x4C, 0x1A, 0xAB, 0xAB, 0xD6, 0xD4, 0x08, 0xF5, 0x0A, 0x1A, 0x0C, 0x30, 0xDB, 0x62, 0x07,
+    0x40, 0x34, 0x9A, 0xA5, 0x0A, 0x15, 0x62, 0xEF, 0xA4, 0x5E, 0x7F, 0x91, 0x8B, 0xF3, 0xD4, 0x63,
+    0xF8, 0x6E, 0x5F, 0xFF, 0x77, 0x8B, 0xF4, 0x52, 0x15, 0x29, 0xC7, 0xAB, 0xFD, 0x5C, 0x5C, 0xDC,
+    0xA1, 0x91, 0xD9, 0xAF, 0x00, 0x19, 0xB6, 0x13, 0x7E, 0x0E, 0x08, 0x1F, 0xA8, 0x26, 0x53, 0xAB,
+    0xF8, 0xC3, 0xC3, 0x42, 0xA9, 0xCB, 0x62, 0x3E, 0x43, 0xC1, 0xCC, 0x64, 0x99, 0x3F, 0xB6, 0x22,
+    0x9E, 0x89, 0x92, 0xE4, 0x7D, 0x15, 0xE4, 0x38, 0xC7, 0x3B, 0xC1, 0xC7, 0xAA, 0x3C, 0xAA, 0x2C,
+    0x96, 0x73, 0x9F, 0x6E, 0x36, 0xA4, 0xF9, 0xEA, 0x1C, 0x8F, 0x95, 0x96, 0x43, 0xAF, 0x9D, 0x83,
+    0xF5, 0x2D, 0x30, 0xE5, 0xF1, 0x8B, 0x00, 0x99, 0xC3, 0x8F, 0xA3, 0x48, 0x4F, 0x2B, 0x89, 0x55,
+    0x65, 0xFB, 0x66, 0xCD, 0x8E, 0xC6, 0xD3, 0xA0, 0x32, 0x34, 0xF5, 0xA4, 0x38, 0x77, 0xD4, 0x57,
+    0xCE, 0xE5, 0x0F, 0x80, 0xB7, 0x9F, 0xF1, 0xDC, 0xCC, 0x8D, 0x86, 0xEE, 0xCA, 0x5C, 0x97, 0x6B,
+    0xE8, 0xD1, 0xC2, 0xE5, 0x8C, 0x5F, 0x14, 0xF4, 0x93, 0x42, 0x37, 0x70, 0x11, 0x0B, 0x57, 0x3E,
+    0x48, 0x3D, 0x79, 0xF8, 0x6A, 0x56, 0x6E, 0x13, 0xF3, 0xA6, 0x40, 0x0E, 0xD3, 0xE5, 0x3B, 0x56,
+    0x31, 0xFD, 0x73, 0x55, 0x67, 0xA0, 0xF5, 0xAE, 0x53, 0x43, 0xBD, 0x87, 0xFB, 0x87, 0x72, 0xDE,
+    0x96, 0x7A, 0x81, 0xB4, 0x26, 0x13, 0x61, 0xE1, 0xCB, 0x91, 0x22, 0x0A, 0x08, 0xEF, 0xFA, 0xF7,
+    0x70, 0x64, 0x27, 0xBE, 0xD5, 0x06, 0x40, 0xA4, 0xCD, 0x95, 0x96, 0xDD, 0x16, 0x03, 0x1E, 0xC7,
+    0x10, 0x1E, 0xE2, 0x7C, 0x11, 0x49, 0x1D, 0x8A, 0xEE, 0x4B, 0x85, 0x3F, 0x4C, 0x8F, 0x36, 0xA5,
+    0x78, 0x97, 0x26, 0x51, 0xD4, 0xCA, 0xE8, 0x06, 0x95, 0xDB, 0x33, 0x91, 0x21, 0x0F, 0x55, 0xAD,
+    0x19, 0xE0, 0x37, 0xD2, 0x24, 0x4E, 0x4C, 0xD3, 0x20, 0x23, 0x17, 0x77, 0xB9, 0x7B, 0x76, 0x45,
+    0x26, 0x7C, 0x71, 0x68, 0x59, 0xAE, 0x91, 0xF7, 0x6B, 0x5D, 0x18, 0x1D, 0xC7, 0x35, 0xCC, 0x8D,
+    0xEF, 0x3D, 0xCC, 0xF9, 0xE7, 0xA2, 0x0A, 0xB7, 0x79, 0x13, 0x45, 0xB0, 0xA3, 0x0D, 0xD6, 0x6A,
+    0xCF, 0x0C, 0x8F, 0x43, 0x10, 0x1D, 0x69, 0x7B, 0x33, 0x32, 0x73, 0x67, 0xA4, 0x3B, 0x87, 0xE7,
+    0x76, 0xA4, 0x6E, 0xE0, 0x29, 0xEE, 0xF6, 0x3B, 0x24, 0xAE, 0x38, 0x00, 0x36, 0x04, 0x04, 0x0D,
+    0x18, 0xF0, 0xC1, 0x5C, 0xF7, 0x02, 0xCA, 0x50, 0xC6, 0x74, 0x81, 0x56, 0xE2, 0xDF, 0xB7, 0x82,
+    0x3D, 0xF3, 0x32, 0xA4, 0x1F, 0x64, 0xDF, 0xB0, 0xA7, 0xC5, 0x6F, 0xAF, 0xE9, 0x05, 0x94, 0x1D,
+    0x37, 0xBD, 0xC6, 0x32, 0x2C, 0x50, 0x99, 0x2A, 0xFD, 0x2E, 0x09, 0x7D, 0xA3, 0x5D, 0xED, 0xBA,
+    0xFA, 0x6E, 0xEA, 0x1B, 0xC4, 0x4C, 0x46, 0x56, 0x96, 0xF4, 0x42, 0xD5, 0x7D, 0x21, 0x55, 0xF8,
+    0xF0, 0xCB, 0x80, 0x60, 0xFC, 0x4F, 0xC2, 0xF9, 0x73, 0xB6, 0xC1, 0x76, 0x41, 0x3C, 0x6C, 0xC7,
+    0xEB, 0x59, 0x38, 0x53, 0x42, 0x22, 0x9C, 0x77, 0xBC, 0xD2, 0x9C, 0x17, 0x6F, 0x51, 0xE9, 0x41,
+    0xDD, 0x77, 0x48, 0xC2, 0xBD, 0xF9, 0x57, 0x8A, 0x3A, 0x66, 0xC6, 0x43, 0x32, 0x84, 0xB1, 0xCC,
+    0x29, 0x51, 0xEC, 0xE8, 0x99, 0x3D, 0x39, 0x10, 0x84, 0x49, 0xAD, 0x62, 0x02, 0x9E, 0x2B, 0xF1,
+    0xE7, 0xE0, 0xF1, 0x6B, 0x03, 0x6B, 0x25, 0x8E, 0x4E, 0xAD, 0x10, 0x16, 0x22, 0xA3, 0xEF, 0x6C,
+    0x9B, 0xCA, 0x6F, 0x5E, 0x41, 0x34, 0x84, 0x88, 0x61, 0x73, 0x9E, 0x5E, 0x81, 0x6F, 0xCA, 0x89,
+    0x89, 0xCB, 0x76, 0x89, 0x1D, 0xB4, 0x99, 0x81, 0x81, 0x36, 0x89, 0x5C, 0x89, 0x4E, 0xF8, 0x76,
+    0xE2, 0x61, 0x59, 0x14, 0xED, 0xAC, 0x86, 0xCA, 0xB7, 0x3B, 0x90, 0x17, 0x55, 0x39, 0xBA, 0xEC,
+    0x86, 0x34, 0x0E, 0xB4, 0x6A, 0x04, 0x4B, 0xAC, 0xAD, 0x2B, 0xC0, 0xD5, 0xF5, 0x96, 0xB1, 0xFB,
+    0xB4, 0x97, 0xE0, 0x6E, 0xEC, 0xBE, 0x62, 0xE4, 0x1B, 0x11, 0xA5, 0xE6, 0xE5, 0xE3, 0xF2, 0x01,
+    0x62, 0x97, 0xB7, 0x25, 0xDB, 0x95, 0x18, 0xD0, 0xCA, 0x8E, 0xF2, 0x6B, 0x83, 0x24, 0x16, 0xD8,
+    0x05, 0x9D, 0xE2, 0xBA, 0xD5, 0x63, 0x1D, 0xFA, 0x72, 0xBC, 0x90, 0x83, 0xCA, 0x55, 0x65, 0x2D,
+    0xA8, 0xB0, 0x69, 0x35, 0x16, 0x9E, 0xAB, 0x76, 0xE2, 0x55, 0x6C, 0x2F, 0x3D, 0x13, 0xF5, 0x68,
+    0x3F, 0x75, 0x5B, 0x0F, 0x09, 0x51, 0xF8, 0x4A, 0x26, 0x05, 0x4C, 0x47, 0x1C, 0x02, 0x6A, 0x62,
+    0xCA, 0x64, 0x12, 0x23, 0x17, 0x22, 0x7C, 0x47, 0x80, 0x00, 0x45, 0x9B, 0x24, 0x95, 0x3F, 0xBA,
+    0xC6, 0xF2, 0x4A, 0x0D, 0x8D, 0xE8, 0xEF, 0xBB, 0xA5, 0xE4, 0x09, 0xC9, 0x2F, 0xD9, 0x6E, 0x82,
+    0xAD, 0xB5, 0x13, 0x9C, 0xCE, 0x9D, 0x08, 0x0B, 0x02, 0x30, 0x11, 0x9A, 0xFC, 0x47, 0xA0, 0xF7,
+    0x48, 0x4D, 0x52, 0xE8, 0x1D, 0x45, 0xCA, 0x55, 0x84, 0xA7, 0x87, 0x6E, 0xB3, 0xB4, 0xC1, 0x51,
+    0x0F, 0x1C, 0xBA, 0xA0, 0x80, 0x64, 0x61, 0xFC, 0xC8, 0xE3, 0xF2, 0x1A, 0xBC, 0x89, 0xBE, 0x4A,
+    0x84, 0x2D, 0x5C, 0xBE, 0x17, 0xBE, 0xF4, 0x6C, 0xF5, 0x8B, 0x39, 0x96, 0x21, 0xEE, 0x14, 0x16,
+    0xF4, 0x1C, 0x38, 0x7A, 0x5C, 0xBA, 0xAA, 0x61, 0xCD, 0x0A, 0xC2, 0xCB, 0x32, 0x2C, 0x24, 0x29,
+    0x33, 0x17, 0xE2, 0x4D, 0xAF, 0xEA, 0x91, 0xAE, 0xEA, 0xBD, 0x67, 0x55, 0xEC, 0x96, 0x5F, 0x78,
+    0x4E, 0xE2, 0xC2, 0xB3, 0x3B, 0xE2, 0x1A, 0x21, 0x26, 0x36, 0x82, 0xA0, 0x74, 0x1F, 0x26, 0xC3,
+    0xC8, 0x38, 0x76, 0x85, 0x7F, 0xBC, 0x60, 0xD8, 0xA8, 0x4D, 0x9F, 0x07, 0xDF, 0xCA, 0x9A, 0xEE,
+    0x60, 0x56, 0x82, 0x3B, 0x31, 0x05, 0x3F, 0x52, 0x54, 0x0E, 0x7F, 0x7E, 0x01, 0x52, 0xEA, 0x71,
+    0xFB, 0x22, 0xE9, 0x7C, 0xDA, 0xE1, 0x38, 0xE0, 0xC4, 0x66,
+};
+
+const uint8_t System5x7[] PROGMEM = {
+    0x00, 0x00, 0x05, 0x07, 0x20, 0x60,
+    0x06, 0x56, 0x11, 0x33, 0x1D, 0x0C, 0x5F, 0x7E, 0x53, 0x73, 0x3C, 0x77, 0x6C, 0x35, 0x05, 0x7C,
+    0x74, 0x75, 0x46, 0x4A, 0x70, 0x68, 0x39, 0x63, 0x48, 0x30, 0x02, 0x11, 0x49, 0x3F, 0x37, 0x04,
+    0x6E, 0x59, 0x6D, 0x61, 0x49, 0x61, 0x7E, 0x3F, 0x46, 0x5C, 0x7E, 0x19, 0x41, 0x41, 0x43, 0x5C,
+    0x2F, 0x3F, 0x6D, 0x23, 0x2E, 0x67, 0x72, 0x4F, 0x38, 0x40, 0x4A, 0x0F, 0x2A, 0x78, 0x14, 0x34,
+    0x2E, 0x33, 0x47, 0x5D, 0x1C, 0x2F, 0x2D, 0x2B, 0x19, 0x5B, 0x1F, 0x11, 0x69, 0x7A, 0x3F, 0x2C,
+    0x40, 0x05, 0x08, 0x2E, 0x6F, 0x04, 0x5A, 0x37, 0x0D, 0x24, 0x26, 0x56, 0x0D, 0x4D, 0x19, 0x5C,
+    0x45, 0x47, 0x7B, 0x3C, 0x6D, 0x2C, 0x19, 0x21, 0x3F, 0x49, 0x02, 0x4F, 0x03, 0x3C, 0x06, 0x66,
+    0x34, 0x10, 0x32, 0x4B, 0x1A, 0x44, 0x21, 0x3C, 0x27, 0x48, 0x28, 0x06, 0x5E, 0x56, 0x61, 0x4A,
+    0x08, 0x2D, 0x79, 0x37, 0x21, 0x67, 0x26, 0x7F, 0x20, 0x2A, 0x2E, 0x0E, 0x53, 0x60, 0x2E, 0x1E,
+    0x70, 0x7F, 0x13, 0x41, 0x4A, 0x0E, 0x0C, 0x66, 0x6C, 0x3B, 0x5A, 0x3F, 0x68, 0x6C, 0x7E, 0x23,
+    0x41, 0x1A, 0x75, 0x49, 0x55, 0x24, 0x79, 0x2E, 0x09, 0x69, 0x21, 0x26, 0x0E, 0x7E, 0x1D, 0x14,
+    0x22, 0x40, 0x01, 0x65, 0x39, 0x7C, 0x71, 0x3C, 0x22, 0x26, 0x73, 0x7E, 0x5A, 0x75, 0x0B, 0x1F,
+    0x69, 0x66, 0x5D, 0x6A, 0x30, 0x31, 0x35, 0x2C, 0x38, 0x66, 0x36, 0x5C, 0x1C, 0x1B, 0x73, 0x1E,
+    0x10, 0x6C, 0x76, 0x3D, 0x40, 0x36, 0x6B, 0x46, 0x2A, 0x32, 0x4B, 0x6B, 0x68, 0x7A, 0x1A, 0x0F,
+    0x7B, 0x36, 0x38, 0x47, 0x71, 0x08, 0x77, 0x6E, 0x4D, 0x1E, 0x46, 0x2D, 0x31, 0x2F, 0x47, 0x06,
+    0x6D, 0x70, 0x17, 0x11, 0x79, 0x39, 0x4F, 0x5B, 0x46, 0x55, 0x0F, 0x4C, 0x26, 0x4B, 0x14, 0x02,
+    0x68, 0x65, 0x17, 0x7B, 0x03, 0x05, 0x45, 0x4B, 0x65, 0x2F, 0x18, 0x3F, 0x04, 0x7E, 0x1C, 0x40,
+    0x3B, 0x4D, 0x60, 0x22, 0x20, 0x46, 0x7C, 0x39, 0x78, 0x60, 0x72, 0x47, 0x07, 0x36, 0x21, 0x4B,
+    0x74, 0x41, 0x28, 0x0A, 0x6F, 0x44, 0x7A, 0x7A, 0x72, 0x53, 0x77, 0x7A, 0x27, 0x44, 0x2D, 0x71,
+    0x54, 0x03, 0x4C, 0x39, 0x0D, 0x72, 0x06, 0x48, 0x08, 0x55, 0x1E, 0x02, 0x46, 0x4A, 0x03, 0x6C,
+    0x75, 0x29, 0x53, 0x54, 0x36, 0x77, 0x0A, 0x22, 0x19, 0x48, 0x4B, 0x77, 0x51, 0x64, 0x15, 0x4F,
+    0x67, 0x32, 0x6B, 0x43, 0x63, 0x0E, 0x67, 0x4C, 0x30, 0x37, 0x0B, 0x5A, 0x1E, 0x39, 0x35, 0x2C,
+    0x50, 0x61, 0x5E, 0x24, 0x44, 0x53, 0x34, 0x5D, 0x62, 0x41, 0x7C, 0x09, 0x72, 0x25, 0x5D, 0x25,
+    0x0E, 0x19, 0x28, 0x27, 0x36, 0x65, 0x12, 0x03, 0x6F, 0x0A, 0x60, 0x2F, 0x00, 0x1F, 0x34, 0x01,
+    0x6B, 0x21, 0x17, 0x75, 0x5F, 0x7E, 0x5A, 0x5D, 0x4E, 0x50, 0x44, 0x23, 0x2A, 0x4C, 0x0B, 0x1C,
+    0x11, 0x3C, 0x37, 0x13, 0x5F, 0x28, 0x63, 0x57, 0x23, 0x26, 0x69, 0x08, 0x49, 0x53, 0x7A, 0x48,
+    0x28, 0x2A, 0x20, 0x1C, 0x22, 0x1B, 0x56, 0x35, 0x12, 0x3F, 0x44, 0x05, 0x4C, 0x1E, 0x75, 0x65,
+    0x67, 0x47, 0x20, 0x77, 0x76, 0x5B, 0x56, 0x4D, 0x44, 0x0E, 0x3F, 0x02, 0x78, 0x18, 0x52, 0x09,
+    0x32, 0x48, 0x19, 0x3B, 0x15, 0x0C, 0x6C, 0x63, 0x0D, 0x2F, 0x49, 0x0F, 0x28, 0x5A, 0x5C, 0x08,
+    0x7E, 0x26, 0x37, 0x57, 0x03, 0x61, 0x51, 0x7F, 0x52, 0x1A, 0x68, 0x0F, 0x00, 0x21, 0x7B, 0x33,
+};
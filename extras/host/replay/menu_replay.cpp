@@ -0,0 +1,249 @@
+// Host replay of input traces recorded with MenuTraceRecorder, for reproducing and guarding the responsiveness of a menu.
+// The loop() of a sketch (by default examples/MenuExample) runs under the virtual clock, so its MenuRunner polls, navigates
+// and draws as on the board: the trace is fed to the runner as an additional input source (events as they are, encoder steps
+// as up/down events, analog values to the analog inputs), and the display goes to the counting Wire stand-in, which blocks
+// for the bus time of every transaction like the real I2C. The latency of an input is the time until the runner is idle again.
+//
+//   menu_replay [options] trace...
+//     --loop-us N        time of one loop() call besides the display, in microseconds (default 100)
+//     --budget-us N      render budget of the runner (default MENU_RUNNER_RENDER_BUDGET, 0: no limit)
+//     --baseline FILE    fail (exit code 1) if a result exceeds the baseline by more than the tolerance
+//     --tolerance PCT    allowed regression in percent (default 5)
+//     --write-baseline FILE  store the results as the new baseline
+//
+// The sketch has to provide mainMenu, a MenuRunner named runner, setup() and loop(); set REPLAY_SKETCH to replay another one.
+
+#include "HostHal.h"
+#ifndef REPLAY_SKETCH
+#define REPLAY_SKETCH "../../examples/MenuExample/MenuExample.ino"
+#endif
+#include REPLAY_SKETCH
+#include <MenuTrace.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+struct ReplayResult {
+    uint32_t events;
+    uint32_t meanLatency;
+    uint32_t p95Latency;
+    uint32_t maxLatency;
+    uint32_t redraws;
+    uint32_t bytes;
+    uint32_t transactions;
+};
+
+// names and values of the results, in the order of the baseline file
+static const char* const resultNames[] = {"mean_latency_us", "p95_latency_us", "max_latency_us", "redraws", "bus_bytes", "transactions"};
+static const uint8_t resultCount = 6;
+
+static void resultValues(const ReplayResult& result, uint32_t* values) {
+    values[0] = result.meanLatency;
+    values[1] = result.p95Latency;
+    values[2] = result.maxLatency;
+    values[3] = result.redraws;
+    values[4] = result.bytes;
+    values[5] = result.transactions;
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path, "rb");
+    if (file==NULL) return false;
+    uint8_t buffer[256];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file))>0) data.insert(data.end(), buffer, buffer+n);
+    fclose(file);
+    return true;
+}
+
+// trace being fed to the runner
+static std::vector<menu_trace_record_t> records;
+static size_t next;
+static uint32_t traceStart;
+static int16_t stepsLeft;               // encoder steps of the current record not queued yet
+static std::vector<uint32_t> waiting;   // times of inputs queued but not shown yet
+
+static uint32_t recordTime(const menu_trace_record_t& record) {
+    return traceStart+record.time*1000UL;
+}
+
+// input source of the runner: queues the records that are due, as far as the queue has room
+static void replayPoll(MenuEventQueue& events) {
+    uint32_t now = micros();
+    while ((next<records.size()) && ((int32_t)(now-recordTime(records[next]))>=0)) {
+        const menu_trace_record_t& record = records[next];
+        if (record.kind==TRACE_ANALOG) {
+            HostHal::setAnalog(record.arg, record.value);
+        } else if (record.kind==TRACE_EVENT) {
+            if (events.count()>=MENU_EVENT_QUEUE_SIZE-1) return;
+            events.push((menu_event_t)record.arg);
+            waiting.push_back(recordTime(record));
+        } else {
+            if (stepsLeft==0) stepsLeft = record.value;
+            // positive steps move up, as with navigateBy
+            while ((stepsLeft!=0) && (events.count()<MENU_EVENT_QUEUE_SIZE-1)) {
+                events.push(stepsLeft>0 ? MENU_UP : MENU_DOWN);
+                stepsLeft += (stepsLeft>0) ? -1 : 1;
+            }
+            if (stepsLeft!=0) return;
+            waiting.push_back(recordTime(record));
+        }
+        next++;
+    }
+}
+
+static bool replay(const char* path, uint32_t loopMicros, uint16_t budgetMicros, ReplayResult& result) {
+    std::vector<uint8_t> data;
+    if (!readFile(path, data)) {
+        fprintf(stderr, "%s: cannot read\n", path);
+        return false;
+    }
+    MenuTraceReader reader(data.data(), data.size());
+    if (!reader.isValid()) {
+        fprintf(stderr, "%s: not a menu trace (version %u)\n", path, MENU_TRACE_VERSION);
+        return false;
+    }
+    std::vector<menu_trace_record_t> trace;
+    menu_trace_record_t record;
+    while (reader.next(record)) trace.push_back(record);
+
+    // same start state for every trace (the top of the root menu); the clock keeps running, since the runner schedules on it,
+    // and jumps to the next full second, where the runner starts a new input grid
+    uint32_t now = micros();
+    HostHal::reset();
+    HostHal::setMicros((now/1000000UL+1)*1000000UL);
+    Wire.setBlocking(true);
+    setup();
+    menuDisplay.invalidate();
+    while (mainMenu.getCurrentSubmenu()!=&mainMenu) mainMenu.leaveSubmenu();
+    mainMenu.navigateBy(mainMenu.getSelectedItem());
+    mainMenu.requestRedraw();
+    records.clear();
+    runner.setPoll(replayPoll);
+    runner.setRenderBudget(budgetMicros);
+    do {
+        loop();
+        HostHal::advanceMicros(loopMicros);
+    } while (!runner.isIdle());
+    runner.resetCounters();
+    display.resetCounters();
+    records.swap(trace);
+    next = 0;
+    stepsLeft = 0;
+    waiting.clear();
+    traceStart = micros();
+
+    std::vector<uint32_t> latencies;
+    uint32_t lastInput = records.empty() ? traceStart : recordTime(records.back());
+    while ((next<records.size()) || !waiting.empty() || !runner.isIdle()) {
+        if ((int32_t)(micros()-lastInput)>10000000L) {
+            fprintf(stderr, "%s: menu still busy 10s after the last input\n", path);
+            return false;
+        }
+        loop();
+        HostHal::advanceMicros(loopMicros);
+        if (runner.isIdle()) {
+            for (size_t i=0; i<waiting.size(); i++) latencies.push_back(micros()-waiting[i]);
+            waiting.clear();
+        }
+    }
+    Wire.setBlocking(false);
+
+    memset(&result, 0, sizeof(result));
+    result.events = latencies.size();
+    if (!latencies.empty()) {
+        uint64_t sum = 0;
+        for (size_t i=0; i<latencies.size(); i++) sum += latencies[i];
+        std::sort(latencies.begin(), latencies.end());
+        result.meanLatency = sum/latencies.size();
+        result.p95Latency = latencies[(latencies.size()*95+99)/100-1];
+        result.maxLatency = latencies.back();
+    }
+    result.redraws = runner.getFrames();
+    result.bytes = Wire.getBytes();
+    result.transactions = Wire.getTransactions();
+    return true;
+}
+
+static const char* baseName(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return (slash!=NULL) ? slash+1 : path;
+}
+
+// baseline file: one line per trace and result, "<trace> <name> <value>"
+static bool findBaseline(const char* file, const char* trace, const char* name, uint32_t& value) {
+    FILE* f = fopen(file, "r");
+    if (f==NULL) return false;
+    char traceName[256], resultName[64];
+    unsigned long v;
+    bool found = false;
+    while (fscanf(f, "%255s %63s %lu", traceName, resultName, &v)==3) {
+        if ((strcmp(traceName, trace)==0) && (strcmp(resultName, name)==0)) {
+            value = v;
+            found = true;
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+int main(int argc, char** argv) {
+    uint32_t loopMicros = 100;
+    uint16_t budgetMicros = MENU_RUNNER_RENDER_BUDGET;
+    uint32_t tolerance = 5;
+    const char* baseline = NULL;
+    const char* writeBaseline = NULL;
+    std::vector<const char*> traces;
+    for (int i=1; i<argc; i++) {
+        if ((strcmp(argv[i], "--loop-us")==0) && (i+1<argc)) loopMicros = atol(argv[++i]);
+        else if ((strcmp(argv[i], "--budget-us")==0) && (i+1<argc)) budgetMicros = atol(argv[++i]);
+        else if ((strcmp(argv[i], "--tolerance")==0) && (i+1<argc)) tolerance = atol(argv[++i]);
+        else if ((strcmp(argv[i], "--baseline")==0) && (i+1<argc)) baseline = argv[++i];
+        else if ((strcmp(argv[i], "--write-baseline")==0) && (i+1<argc)) writeBaseline = argv[++i];
+        else if (argv[i][0]=='-') {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        } else traces.push_back(argv[i]);
+    }
+    if (traces.empty()) {
+        fprintf(stderr, "usage: %s [--loop-us N] [--budget-us N] [--baseline FILE] [--tolerance PCT] [--write-baseline FILE] trace...\n", argv[0]);
+        return 2;
+    }
+
+    FILE* out = NULL;
+    if (writeBaseline!=NULL) {
+        out = fopen(writeBaseline, "w");
+        if (out==NULL) {
+            fprintf(stderr, "%s: cannot write\n", writeBaseline);
+            return 2;
+        }
+    }
+    bool failed = false;
+    printf("%-28s %7s %9s %9s %9s %8s %9s %8s\n", "trace", "events", "mean us", "p95 us", "max us", "redraws", "bus B", "txn");
+    for (size_t t=0; t<traces.size(); t++) {
+        ReplayResult result;
+        if (!replay(traces[t], loopMicros, budgetMicros, result)) {
+            failed = true;
+            continue;
+        }
+        const char* name = baseName(traces[t]);
+        printf("%-28s %7u %9u %9u %9u %8u %9u %8u\n", name, result.events, result.meanLatency, result.p95Latency,
+            result.maxLatency, result.redraws, result.bytes, result.transactions);
+        uint32_t values[resultCount];
+        resultValues(result, values);
+        for (uint8_t i=0; i<resultCount; i++) {
+            if (out!=NULL) fprintf(out, "%s %s %u\n", name, resultNames[i], values[i]);
+            uint32_t limit;
+            if ((baseline==NULL) || !findBaseline(baseline, name, resultNames[i], limit)) continue;
+            if ((uint64_t)values[i]*100 > (uint64_t)limit*(100+tolerance)) {
+                printf("  REGRESSION %s: %u, baseline %u (+%u%% allowed)\n", resultNames[i], values[i], limit, tolerance);
+                failed = true;
+            }
+        }
+    }
+    if (out!=NULL) fclose(out);
+    if (baseline!=NULL) printf("%s\n", failed ? "FAILED" : "baseline ok");
+    return failed ? 1 : 0;
+}
@@ -6,35 +6,180 @@ void Parameter::increment() {
 void Parameter::decrement() {
 };
 
+void Parameter::incrementBy(int16_t steps) {
+    for (; steps>0; steps--) increment();
+    for (; steps<0; steps++) decrement();
+};
+
+void Parameter::setScaledFraction(uint16_t fraction) {
+};
+
 void Parameter::setScaledValue(float value) {
+    if (value<0.0f) value = 0.0f;
+    if (value>1.0f) value = 1.0f;
+    setScaledFraction((uint16_t)(value*65535.0f+0.5f));
+};
+
+void Parameter::notify() {
+    if (dispatcher==NULL) deliver();
+    else dispatcher->post(this);
+};
+
+bool Parameter::setDispatcher(ParameterDispatcher* newDispatcher) {
+    if (newDispatcher!=NULL) return newDispatcher->add(this);
+    if (dispatcher!=NULL) dispatcher->remove(this);
+    return true;
+};
+
+void (*Parameter::commitHandler)(Parameter*) = NULL;
+
+void Parameter::commit() {
+    if (dispatcher!=NULL) dispatcher->commit(this);
+    if (commitHandler!=NULL) commitHandler(this);
+};
+
+bool Parameter::isPending() {
+    return (dispatcher!=NULL) && dispatcher->isPending(this);
+};
+
+ParameterDispatcher::ParameterDispatcher(uint16_t interval, dispatch_mode_t mode):
+count(0), pendingMask(0), lastTime(0), interval(interval), mode(mode), posted(0), delivered(0) {
+};
+
+ParameterDispatcher::~ParameterDispatcher() {
+    flush();
+    for (uint8_t i=0; i<count; i++) parameters[i]->dispatcher = NULL;
+};
+
+int8_t ParameterDispatcher::indexOf(Parameter* parameter) {
+    for (uint8_t i=0; i<count; i++) if (parameters[i]==parameter) return i;
+    return -1;
+};
+
+bool ParameterDispatcher::add(Parameter* parameter) {
+    if (parameter->dispatcher==this) return true;
+    if (count>=PARAMETER_DISPATCHER_SIZE) return false;
+    // a pending callback goes with the old dispatcher
+    if (parameter->dispatcher!=NULL) parameter->dispatcher->remove(parameter);
+    parameters[count++] = parameter;
+    parameter->dispatcher = this;
+    return true;
 };
 
-void Parameter::getValueAsString(char* valueBuffer) {valueBuffer="?";};
+void ParameterDispatcher::remove(Parameter* parameter) {
+    int8_t index = indexOf(parameter);
+    if (index<0) return;
+    deliver(index);
+    parameter->dispatcher = NULL;
+    // the last parameter takes the free place, with its pending bit
+    count--;
+    parameters[index] = parameters[count];
+    if (pendingMask & (1U<<count)) pendingMask |= 1U<<index;
+    pendingMask &= ~(1U<<count);
+};
+
+void ParameterDispatcher::post(Parameter* parameter) {
+    // the slot is looked up only among the parameters of this dispatcher
+    int8_t index = indexOf(parameter);
+    if (index<0) return;
+    posted++;
+    if (mode==DISPATCH_SETTLE) lastTime = millis();
+    pendingMask |= 1U<<index;
+};
 
-void ParameterInt16::getValueAsString(char* valueBuffer) {
-    itoa(value, valueBuffer, 10);
+bool ParameterDispatcher::isPending(Parameter* parameter) {
+    int8_t index = indexOf(parameter);
+    return (index>=0) && (pendingMask & (1U<<index));
 };
 
-void ParameterInt16::increment() {
-    value += stepsize;
-    if (value>maxval) value=maxval;
-    if (callback!=NULL) callback(this);
+void ParameterDispatcher::run() {
+    if (pendingMask==0) return;
+    uint32_t now = millis();
+    if (mode==DISPATCH_RATE) {
+        if (now-lastTime<interval) return;
+        lastTime = now;
+    } else {
+        if ((interval==0) || (now-lastTime<interval)) return;
+    }
+    deliverAll();
 };
 
-void ParameterInt16::decrement() {
-    value -= stepsize;
-    if (value<minval) value=minval;
-    if (callback!=NULL) callback(this);
+void ParameterDispatcher::deliver(uint8_t index) {
+    uint16_t bit = 1U<<index;
+    if (!(pendingMask & bit)) return;
+    pendingMask &= ~bit;
+    parameters[index]->deliver();
+    delivered++;
 };
 
-void ParameterInt16::setScaledValue(float newValue) {
-    setValue(int16_t(newValue*(maxval-minval)+minval));
+void ParameterDispatcher::deliverAll() {
+    // only the parameters pending now: a callback changing parameters marks them for the next delivery
+    uint16_t due = pendingMask;
+    pendingMask &= ~due;
+    for (uint8_t i=0; due!=0; i++, due>>=1) {
+        if (!(due & 1)) continue;
+        parameters[i]->deliver();
+        delivered++;
+    }
 };
 
+void ParameterDispatcher::commit(Parameter* parameter) {
+    int8_t index = indexOf(parameter);
+    if (index>=0) deliver(index);
+};
+
+void Parameter::getValueAsString(char* valueBuffer) {
+    MenuTextBuffer text(valueBuffer, PARAMETER_VALUE_LENGTH+1);
+    printValue(text);
+};
 
-void ParameterInt16::setValue(int16_t newValue) {
+size_t Parameter::printValue(Print& out) {return out.print('?');};
+
+// default labels of ParameterBool
+static const char boolOff[] PROGMEM = "off";
+static const char boolOn[] PROGMEM = "on";
+static const char* const boolLabels[] PROGMEM = {boolOff, boolOn};
+
+void ParameterBool::store(bool newValue) {
+    // no callback for a value held at the end of the range (e.g. while a button repeats)
+    if (newValue==value) return;
     value = newValue;
-    if (value<minval) value=minval;
-    if (value>maxval) value=maxval;
-    if (callback!=NULL) callback(this);
+    markChanged();
+    notify();
+};
+
+void ParameterBool::incrementBy(int16_t steps) {
+    if (steps!=0) store(steps>0);
+};
+
+size_t ParameterBool::printValue(Print& out) {
+    const char* const* table = (labels!=NULL) ? labels : boolLabels;
+    return out.print((const __FlashStringHelper*)pgm_read_ptr(&table[value ? 1 : 0]));
+};
+
+void ParameterEnum::store(uint8_t newValue) {
+    // no callback for a value held at the end of the range (e.g. while a button repeats)
+    if (newValue==value) return;
+    value = newValue;
+    markChanged();
+    notify();
+};
+
+void ParameterEnum::incrementBy(int16_t steps) {
+    if (count==0) return; // no options to select
+    int16_t newValue = (int16_t)value + steps;
+    if (newValue>=count) newValue = count-1;
+    if (newValue<0) newValue = 0;
+    store(newValue);
+};
+
+void ParameterEnum::setScaledFraction(uint16_t fraction) {
+    // equal parts of the range for all options
+    uint8_t newValue = ((uint32_t)fraction*count) >> 16;
+    store(newValue);
+};
+
+size_t ParameterEnum::printValue(Print& out) {
+    if (count==0) return 0;
+    return out.print(getLabel());
 };
@@ -1,6 +1,35 @@
 #ifndef PARAMETERS_H
 #define PARAMETERS_H
 #include <Arduino.h>
+#include "NumberFormat.h"
+#include "MenuText.h"
+
+// maximum number of characters written by getValueAsString
+#ifndef PARAMETER_VALUE_LENGTH
+#define PARAMETER_VALUE_LENGTH 15
+#endif
+
+// maximum number of bytes of a saved parameter value
+#define PARAMETER_STORAGE_SIZE 4
+
+// default time in milliseconds between deliveries of a ParameterDispatcher
+#ifndef PARAMETER_DISPATCH_INTERVAL
+#define PARAMETER_DISPATCH_INTERVAL 50
+#endif
+
+// maximum number of parameters one ParameterDispatcher handles (up to 16)
+#ifndef PARAMETER_DISPATCHER_SIZE
+#define PARAMETER_DISPATCHER_SIZE 8
+#endif
+#if PARAMETER_DISPATCHER_SIZE>16
+#error "PARAMETER_DISPATCHER_SIZE: the pending mask has 16 bits"
+#endif
+
+// when a ParameterDispatcher delivers pending callbacks (besides on commit): at most once per interval, or when no
+// parameter changed for an interval
+typedef enum dispatch_mode_t {DISPATCH_RATE, DISPATCH_SETTLE} dispatch_mode_t;
+
+class ParameterDispatcher;
 
 /**
  * @class Parameter
@@ -12,78 +41,437 @@
 class Parameter {
 private:
   char* name;
+  ParameterDispatcher* dispatcher; // NULL: callbacks are called right away
+  static void (*commitHandler)(Parameter*); // e.g. saving, see ParameterStore::saveOnCommit
+  friend class ParameterDispatcher;
+  friend class ParameterStore;
+protected:
+  uint8_t version; // changes with every change of the value
+  
+  /**
+   * @brief Subclasses call this instead of their callback: it is called right away, or later by the dispatcher.
+   */
+  void notify();
+  
+  /**
+   * @brief Calls the callback of the subclass.
+   */
+  virtual void deliver() {};
 public:
     /**
      * @brief Constructor for parameter. Takes a name.
      * @param aname The name of the parameter.
      */
     Parameter(char* aname):
-        name (aname) {};
+        name (aname), dispatcher(NULL), version(0) {};
     virtual char* getName() {return name;};
+    /**
+     * @brief Change counter of the value, e.g. for displays to skip parameters that did not change since they were drawn.
+     *        Wraps around after 256 changes.
+     */
+    uint8_t getVersion() {return version;};
+    /**
+     * @brief Bumps the version. Subclasses call this when their value changes.
+     */
+    void markChanged() {version++;};
+    /**
+     * @brief Writes the value as text (what printValue prints).
+     * @param valueBuffer destination, at least PARAMETER_VALUE_LENGTH+1 chars (longer text is truncated)
+     */
     virtual void getValueAsString(char* valueBuffer);
+    /**
+     * @brief Prints the current value, e.g. to the display or into a MenuTextBuffer.
+     * @param out destination
+     * @return number of characters written
+     */
+    virtual size_t printValue(Print& out);
     virtual void increment();
     virtual void decrement();
+    /**
+     * @brief Applies several increments (positive steps) or decrements (negative steps) at once.
+     *        Subclasses override this to update the value and call their callback only once.
+     * @param steps Number of increments, negative for decrements
+     */
+    virtual void incrementBy(int16_t steps);
+    /**
+     * @brief Sets the value to a position in its range (integer arithmetic in the numeric parameters).
+     * @param fraction 0 for the minimum .. 65535 for the maximum
+     */
+    virtual void setScaledFraction(uint16_t fraction);
+    /**
+     * @brief Float wrapper of setScaledFraction.
+     * @param value position in the range (0.0 .. 1.0)
+     */
     virtual void setScaledValue(float value);
+    /**
+     * @brief Reports value and range of parameters with a numeric range, e.g. for drawing a bar.
+     * @return false if the parameter has no range (the arguments are left unchanged)
+     */
+    virtual bool getRange(int32_t& current, int32_t& minimum, int32_t& maximum) {return false;};
+    
+    /**
+     * @brief Number of bytes save() writes, at most PARAMETER_STORAGE_SIZE (0: the parameter is not stored).
+     */
+    virtual uint8_t getStorageSize() {return 0;};
+    /**
+     * @brief Writes the value in getStorageSize() bytes, e.g. for a ParameterStore.
+     */
+    virtual void save(uint8_t* data) {};
+    /**
+     * @brief Sets the value written by save(), limited to the range. Triggers callback if the value changed.
+     */
+    virtual void load(const uint8_t* data) {};
+    
+    /**
+     * @brief Defers the change callback to a dispatcher: changes are collected, and the callback is called once with
+     *        the latest value when the dispatcher delivers. NULL restores immediate callbacks. Same as dispatcher->add(this).
+     * @return false if the dispatcher is full
+     */
+    bool setDispatcher(ParameterDispatcher* newDispatcher);
+    
+    /**
+     * @brief The dispatcher the parameter was added to, or NULL if it calls its callback right away.
+     */
+    ParameterDispatcher* getDispatcher() {return dispatcher;};
+    
+    /**
+     * @brief Delivers a pending callback now, e.g. when editing ends, and calls the commit handler. Called by ParamMenuItem
+     *        on MENU_SELECT and MENU_LEAVE.
+     */
+    void commit();
+    
+    /**
+     * @brief Function called with the parameter whenever editing of any parameter is committed (NULL: none).
+     */
+    static void setCommitHandler(void (*handler)(Parameter*)) {commitHandler = handler;};
+    
+    bool isPending();
 };
 
 /**
- * @class ParameterInt16
- * @author felix
- * @date 14/05/19
+ * @class ParameterDispatcher
  * @file parameters.h
- * @brief Integer subclass of Parameter (16 bit), which defines a range and increment step size.
+ * @brief Deferred delivery of parameter callbacks, for callbacks that do expensive work (e.g. reprogramming hardware over SPI).
+ *        A changed parameter is marked pending once, no matter how often it changes before delivery, and its callback then
+ *        sees the latest value; so editing stays fluid while the callbacks run at a bounded rate, and the final value is always
+ *        delivered. Call run() once per loop. A parameter is also delivered right away when its editing is committed.
+ *        The dispatched parameters are kept in the dispatcher (up to PARAMETER_DISPATCHER_SIZE), with a bit mask of the
+ *        pending ones; a parameter only points to its dispatcher, so a parameter without one reports changes in constant time.
  */
-class ParameterInt16: public Parameter {
+class ParameterDispatcher {
 private:
-  int16_t value;  // parameter value
-  int16_t minval; // minimum limit of range
-  int16_t maxval; // maximum limit of range
-  int16_t stepsize; // the step size for incrementing and decrementing
-  void (*callback)(ParameterInt16*); // optional callback that is called when the parameter changes
+  Parameter* parameters[PARAMETER_DISPATCHER_SIZE];
+  uint8_t count;
+  uint16_t pendingMask; // bit i: parameters[i] waits for its callback
+  uint32_t lastTime; // last delivery (DISPATCH_RATE) or last change (DISPATCH_SETTLE)
+  uint16_t interval;
+  dispatch_mode_t mode;
+  uint16_t posted;
+  uint16_t delivered;
+  
+  int8_t indexOf(Parameter* parameter);
+  void post(Parameter* parameter);
+  void deliver(uint8_t index);
+  void deliverAll();
+  friend class Parameter;
 public:
   /**
-   * @brief Constructor for 16-bit parameter.
+   * @brief Constructor for a dispatcher.
+   * @param interval in milliseconds: minimum time between deliveries (DISPATCH_RATE), or time without changes before
+   *        delivering (DISPATCH_SETTLE; 0 delivers only on commit)
+   * @param mode DISPATCH_RATE or DISPATCH_SETTLE
+   */
+  ParameterDispatcher(uint16_t interval=PARAMETER_DISPATCH_INTERVAL, dispatch_mode_t mode=DISPATCH_RATE);
+  ~ParameterDispatcher();
+  
+  /**
+   * @brief Defers the callbacks of a parameter to this dispatcher, moving it from another dispatcher if needed.
+   *        Remove a parameter before it is destroyed if the dispatcher lives longer.
+   * @return false if PARAMETER_DISPATCHER_SIZE parameters are already added
+   */
+  bool add(Parameter* parameter);
+  
+  /**
+   * @brief Restores immediate callbacks of a parameter (a pending callback is delivered first).
+   */
+  void remove(Parameter* parameter);
+  
+  /**
+   * @brief Delivers the pending callbacks that are due.
+   */
+  void run();
+  
+  /**
+   * @brief Delivers the callback of one parameter now, if it is pending.
+   */
+  void commit(Parameter* parameter);
+  
+  /**
+   * @brief Delivers all pending callbacks now.
+   */
+  void flush() {deliverAll();};
+  
+  bool isPending() {return pendingMask!=0;};
+  bool isPending(Parameter* parameter);
+  uint16_t getPosted() {return posted;};       // changes reported by parameters
+  uint16_t getDelivered() {return delivered;}; // callbacks called
+  void resetCounters() {posted = 0; delivered = 0;};
+};
+
+/**
+ * @brief Scales a range by a fraction in 0..65535 (65535 is the full range), rounded, without float or 64 bit arithmetic.
+ */
+inline uint32_t scaleFraction(uint32_t range, uint16_t fraction) {
+  if (fraction==0xFFFF) return range;
+  // range*fraction/65536 from two 16x16 bit products
+  return (range>>16)*fraction + (((range & 0xFFFF)*fraction + 0x8000) >> 16);
+}
+
+/*
+ * Policies for ParameterT: static functions for clamping, stepping, scaling and printing a value type, resolved at compile time.
+ */
+
+/**
+ * @brief Integers; Wide is a type that holds the sum of a value and any number of steps.
+ */
+template<typename T, typename Wide=int32_t>
+struct IntegerPolicy {
+  static T clamp(Wide value, T minval, T maxval) {return value<minval ? minval : (value>maxval ? maxval : (T)value);};
+  static T add(T value, int16_t steps, T stepsize, T minval, T maxval) {return clamp((Wide)value + (Wide)steps*stepsize, minval, maxval);};
+  static T scale(uint16_t fraction, T minval, T maxval) {
+    return (T)((Wide)minval + (Wide)scaleFraction((uint32_t)((Wide)maxval-minval), fraction));
+  };
+  static size_t print(Print& out, T value) {
+    char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    formatNumber(buffer, value);
+    return out.print(buffer);
+  };
+  static void range(T value, T minval, T maxval, int32_t& current, int32_t& minimum, int32_t& maximum) {
+    current = value; minimum = minval; maximum = maxval;
+  };
+};
+
+/**
+ * @brief Fixed-point integers, e.g. a value of 1234 with 2 decimals is shown as "12.34". Ranges and steps are given in the
+ *        smallest unit (0.01 here).
+ */
+template<typename T, uint8_t decimals, typename Wide=int32_t>
+struct FixedPolicy: public IntegerPolicy<T, Wide> {
+  static size_t print(Print& out, T value) {
+    char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    formatFixed(buffer, value, decimals);
+    return out.print(buffer);
+  };
+};
+
+/**
+ * @brief Floats, shown with a fixed number of decimals. Ranges are reported in thousandths of the range.
+ */
+template<uint8_t decimals>
+struct FloatPolicy {
+  static float clamp(float value, float minval, float maxval) {return value<minval ? minval : (value>maxval ? maxval : value);};
+  static float add(float value, int16_t steps, float stepsize, float minval, float maxval) {return clamp(value + steps*stepsize, minval, maxval);};
+  static float scale(uint16_t fraction, float minval, float maxval) {return minval + (maxval-minval)*(fraction*(1.0f/65535.0f));};
+  static size_t print(Print& out, float value) {
+    char buffer[NUMBER_FORMAT_BUFFER_SIZE];
+    formatFloat(buffer, value, decimals);
+    return out.print(buffer);
+  };
+  static void range(float value, float minval, float maxval, int32_t& current, int32_t& minimum, int32_t& maximum) {
+    minimum = 0;
+    maximum = 1000;
+    current = maxval>minval ? (int32_t)((value-minval)*1000.0f/(maxval-minval)) : 0;
+  };
+};
+
+/**
+ * @class ParameterT
+ * @file parameters.h
+ * @brief Numeric parameter with a range and a step size, for any value type T with a Policy (see the typedefs below). Stepping,
+ *        clamping and scaling are resolved at compile time, and the parameter only stores four values of type T.
+ */
+template<typename T, class Policy>
+class ParameterT: public Parameter {
+public:
+  typedef void (*Callback)(ParameterT*);
+protected:
+  T value;    // parameter value
+  T minval;   // minimum limit of range
+  T maxval;   // maximum limit of range
+  T stepsize; // the step size for incrementing and decrementing
+  Callback callback; // optional callback that is called when the parameter changes
+  
+  void store(T newValue) {
+    if (newValue==value) return; // nothing to report for a value held at the end of the range
+    value = newValue;
+    markChanged();
+    notify();
+  };
+  virtual void deliver() {if (callback!=NULL) callback(this);};
+public:
+  /**
+   * @brief Constructor for a numeric parameter.
    * @param aname Name of parameter (string)
    * @param value Initial value of parameter
    * @param minval Minimum limit of range
    * @param maxval Maximum limit of range
    * @param stepsize Step size for incrementing/decrementing 
+   * @param callback optional function called when the parameter changes
    */
-  ParameterInt16(char* aname, int16_t value, int16_t minval, int16_t maxval, int16_t stepsize, void (*callback)(ParameterInt16*) = NULL) :
-   Parameter (aname), value(value), minval(minval), maxval(maxval), stepsize(stepsize), callback(callback) {};
+  ParameterT(char* aname, T value, T minval, T maxval, T stepsize, Callback callback=NULL):
+  Parameter(aname), value(value), minval(minval), maxval(maxval), stepsize(stepsize), callback(callback) {};
+  
+  /**
+   * @brief Adds stepsize to value, up to maximum of range. Triggers callback if the value changed.
+   */
+  virtual void increment() {incrementBy(1);};
+  /**
+   * @brief Subtracts stepsize from value, down to minimum of range. Triggers callback if the value changed.
+   */
+  virtual void decrement() {incrementBy(-1);};
+  /**
+   * @brief Adds steps*stepsize to value, clamped to the range. Triggers callback once if the value changed.
+   * @param steps Number of increments, negative for decrements
+   */
+  virtual void incrementBy(int16_t steps) {store(Policy::add(value, steps, stepsize, minval, maxval));};
+  /**
+   * @brief Set value of the parameter, clamped to the range. Triggers callback if the value changed.
+   * @param newValue The new value. 
+   */
+  void setValue(T newValue) {store(Policy::clamp(newValue, minval, maxval));};
+  virtual void setScaledFraction(uint16_t fraction) {store(Policy::scale(fraction, minval, maxval));};
+  
+  /**
+   * @brief Returns current parameter value.
+   * @return parameter value
+   */
+  T getValue() {return value;};
+  T getMinimum() {return minval;};
+  T getMaximum() {return maxval;};
+  
+  virtual size_t printValue(Print& out) {return Policy::print(out, value);};
+  virtual bool getRange(int32_t& current, int32_t& minimum, int32_t& maximum) {
+    Policy::range(value, minval, maxval, current, minimum, maximum);
+    return true;
+  };
+  
+  virtual uint8_t getStorageSize() {return sizeof(T);};
+  virtual void save(uint8_t* data) {memcpy(data, &value, sizeof(T));};
+  virtual void load(const uint8_t* data) {
+    T newValue;
+    memcpy(&newValue, data, sizeof(T));
+    if (newValue==newValue) setValue(newValue); // not a NaN
+  };
+};
 
-    /**
-     * @brief Adds stepsize to value, up to maximum of range. Triggers callback.
-     */
-    virtual void increment();
-    /**
-     * @brief Subtracts stepsize from value, down to minimum of range. Triggers callback.
-     */
-    virtual void decrement();
-    /**
-     * @brief Set value of the parameter. Triggers callback.
-     * @param newValue The new value. 
-     */
-    virtual void setValue(int16_t newValue);
-    /**
-     * @brief Wrapper function override of parent class.
-     * @param value New value of the parameter as a percentage of the defined range (0.0 .. 1.0).
-     */
-    virtual void setScaledValue(float value);
-    
-    /**
-     * @brief Returns current parameter value.
-     * @return parameter value
-     */
-    int16_t getValue(){return value;};
-    
-    /**
-     * @brief Returns current value as a string representation.
-     * @param valueBuffer Output char buffer to hold the result.
-     */
-    virtual void getValueAsString(char* valueBuffer);
+typedef ParameterT<int8_t, IntegerPolicy<int8_t> > ParameterInt8;
+typedef ParameterT<uint8_t, IntegerPolicy<uint8_t> > ParameterUInt8;
+// 16 bit integer parameter, the original parameter type
+typedef ParameterT<int16_t, IntegerPolicy<int16_t> > ParameterInt16;
+typedef ParameterT<int32_t, IntegerPolicy<int32_t, int64_t> > ParameterInt32;
+// fixed-point parameters, e.g. ParameterFixed<2> for values from -327.68 to 327.67 in steps of 0.01
+template<uint8_t decimals> using ParameterFixed = ParameterT<int16_t, FixedPolicy<int16_t, decimals> >;
+template<uint8_t decimals> using ParameterFixed32 = ParameterT<int32_t, FixedPolicy<int32_t, decimals, int64_t> >;
+template<uint8_t decimals> using ParameterFloat = ParameterT<float, FloatPolicy<decimals> >;
 
+/**
+ * @class ParameterBool
+ * @file parameters.h
+ * @brief On/off parameter in a single byte. Up switches on, down switches off; shown as "on"/"off" or with own labels.
+ */
+class ParameterBool: public Parameter {
+private:
+  bool value;
+  const char* const* labels; // PROGMEM table of the off and on label (NULL: "off", "on")
+  void (*callback)(ParameterBool*);
+  void store(bool newValue);
+protected:
+  virtual void deliver() {if (callback!=NULL) callback(this);};
+public:
+  /**
+   * @brief Constructor for a bool parameter.
+   * @param aname Name of parameter (string)
+   * @param value Initial value
+   * @param callback optional function called when the parameter changes
+   * @param labels optional PROGMEM table of two PROGMEM strings, shown for false and true
+   */
+  ParameterBool(char* aname, bool value, void (*callback)(ParameterBool*)=NULL, const char* const* labels=NULL):
+  Parameter(aname), value(value), labels(labels), callback(callback) {};
+  
+  virtual void increment() {store(true);};
+  virtual void decrement() {store(false);};
+  virtual void incrementBy(int16_t steps);
+  virtual void setScaledFraction(uint16_t fraction) {store(fraction>=0x8000);};
+  void setValue(bool newValue) {store(newValue);};
+  bool getValue() {return value;};
+  virtual size_t printValue(Print& out);
+  virtual bool getRange(int32_t& current, int32_t& minimum, int32_t& maximum) {
+    current = value; minimum = 0; maximum = 1;
+    return true;
+  };
+  virtual uint8_t getStorageSize() {return 1;};
+  virtual void save(uint8_t* data) {data[0] = value;};
+  virtual void load(const uint8_t* data) {store(data[0]!=0);};
+};
+
+/**
+ * @class ParameterEnum
+ * @file parameters.h
+ * @brief Choice from a list of up to 255 named options, stored as an index in one byte. The labels stay in flash:
+ *          const char modeSlow[] PROGMEM = "slow";
+ *          const char modeFast[] PROGMEM = "fast";
+ *          const char* const modeLabels[] PROGMEM = {modeSlow, modeFast};
+ *          ParameterEnum mode("Mode", 0, modeLabels, 2);
+ */
+class ParameterEnum: public Parameter {
+private:
+  uint8_t value;
+  uint8_t count;
+  const char* const* labels; // PROGMEM table of PROGMEM strings
+  void (*callback)(ParameterEnum*);
+  void store(uint8_t newValue);
+protected:
+  virtual void deliver() {if (callback!=NULL) callback(this);};
+public:
+  /**
+   * @brief Constructor for an enum parameter.
+   * @param aname Name of parameter (string)
+   * @param value Index of the initial option
+   * @param labels PROGMEM table of count PROGMEM strings
+   * @param count Number of options
+   * @param callback optional function called when the parameter changes
+   */
+  ParameterEnum(char* aname, uint8_t value, const char* const* labels, uint8_t count, void (*callback)(ParameterEnum*)=NULL):
+  Parameter(aname), value(value<count ? value : 0), count(count), labels(labels), callback(callback) {};
+  
+  virtual void increment() {incrementBy(1);};
+  virtual void decrement() {incrementBy(-1);};
+  virtual void incrementBy(int16_t steps);
+  virtual void setScaledFraction(uint16_t fraction);
+  void setValue(uint8_t newValue) {store(newValue<count ? newValue : count-1);};
+  uint8_t getValue() {return value;};
+  uint8_t getCount() {return count;};
+  /**
+   * @brief Label of the current option (a PROGMEM string).
+   */
+  const __FlashStringHelper* getLabel() {return (const __FlashStringHelper*)pgm_read_ptr(&labels[value]);};
+  virtual size_t printValue(Print& out);
+  virtual bool getRange(int32_t& current, int32_t& minimum, int32_t& maximum) {
+    current = value; minimum = 0; maximum = count-1;
+    return true;
+  };
+  virtual uint8_t getStorageSize() {return 1;};
+  virtual void save(uint8_t* data) {data[0] = value;};
+  virtual void load(const uint8_t* data) {setValue(data[0]);};
 };
 
+#if defined(__AVR__)
+// RAM per parameter on AVR (2 byte pointers, no padding): vtable pointer, name and version, then the members of the type
+static_assert(sizeof(Parameter)==7, "Parameter: vtable pointer, name, dispatcher, version");
+static_assert(sizeof(ParameterBool)==12, "ParameterBool grew");
+static_assert(sizeof(ParameterEnum)==13, "ParameterEnum grew");
+static_assert(sizeof(ParameterInt8)==13, "ParameterInt8 grew");
+static_assert(sizeof(ParameterInt16)==17, "ParameterInt16 grew");
+#endif
 
 #endif
\ No newline at end of file